@@ -301,6 +301,12 @@ public:
                        ->InvalidateImage(image);
     }
 
+    DrawingEngineFrameStats GetFrameStats() override
+    {
+        // The whole screen is redrawn every frame
+        return { };
+    }
+
     rct_drawpixelinfo * GetDPI()
     {
         return &_bitsDPI;
@@ -117,6 +117,7 @@ namespace OpenRCT2
 
         ~Context() override
         {
+            scenario_save_wait_for_background();
             network_close();
             http_dispose();
             language_close_all();
@@ -544,6 +545,7 @@ namespace OpenRCT2
         {
             if (!gConfigGeneral.uncap_fps) return false;
             if (gGameSpeed > 4) return false;
+            if (gGameTurbo) return false;
             if (gOpenRCT2Headless) return false;
             if (_uiContext->IsMinimised()) return false;
             return true;
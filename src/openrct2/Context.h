@@ -114,6 +114,8 @@ enum
     GAME_MAX_UPDATES = 4,
     // The maximum threshold to advance.
     GAME_UPDATE_MAX_THRESHOLD = GAME_UPDATE_TIME_MS * GAME_MAX_UPDATES,
+    // The time spent running ticks between frames in turbo mode, so about 10 frames are drawn per second
+    GAME_TURBO_FRAME_TIME_MS = 100,
 };
 
 /**
@@ -129,10 +129,16 @@ namespace Imaging
 
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path)
     {
-        bool result = false;
-
-        // Get image size
         int stride = dpi->width + dpi->pitch;
+        return PngWriteRows(dpi->width, dpi->height, palette, path, [dpi, stride](sint32 y) -> const uint8 *
+        {
+            return dpi->bits + y * stride;
+        });
+    }
+
+    bool PngWriteRows(sint32 width, sint32 height, const rct_palette * palette, const utf8 * path, const std::function<const uint8 *(sint32 y)> &getRow)
+    {
+        bool result = false;
 
         // Setup PNG
         png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -173,7 +179,7 @@ namespace Imaging
 
             // Write header
             png_set_IHDR(
-                png_ptr, info_ptr, dpi->width, dpi->height, 8,
+                png_ptr, info_ptr, width, height, 8,
                 PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT
             );
             png_byte transparentIndex = 0;
@@ -181,11 +187,9 @@ namespace Imaging
             png_write_info(png_ptr, info_ptr);
 
             // Write pixels
-            uint8 * bits = dpi->bits;
-            for (int y = 0; y < dpi->height; y++)
+            for (int y = 0; y < height; y++)
             {
-                png_write_row(png_ptr, (png_byte *)bits);
-                bits += stride;
+                png_write_row(png_ptr, (png_bytep)getRow(y));
             }
 
             // Finish
@@ -22,10 +22,17 @@
 
 #ifdef __cplusplus
 
+#include <functional>
+
 namespace Imaging
 {
     bool PngRead(uint8 * * pixels, uint32 * width, uint32 * height, const utf8 * path);
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path);
+
+    /**
+     * Writes an 8 bit paletted PNG, asking for each row in turn so that the image never has to be in memory at once.
+     */
+    bool PngWriteRows(sint32 width, sint32 height, const rct_palette * palette, const utf8 * path, const std::function<const uint8 *(sint32 y)> &getRow);
     bool PngWrite32bpp(sint32 width, sint32 height, const void * pixels, const utf8 * path);
 }
 
@@ -24,6 +24,7 @@
 #include "../localisation/localisation.h"
 #include "../ride/ride.h"
 #include "../world/park.h"
+#include "../world/ParkStatistics.h"
 
 struct RideDemolishAction : public GameActionBase<GAME_COMMAND_DEMOLISH_RIDE, GameActionResult>
 {
@@ -177,6 +178,7 @@ public:
                     peep->thoughts[PEEP_MAX_THOUGHTS - 1].type = PEEP_THOUGHT_TYPE_NONE;
                 }
             }
+            park_statistics_update_peep(peep);
         }
 
         user_string_free(ride->name);
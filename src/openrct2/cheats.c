@@ -28,6 +28,7 @@
 #include "world/footpath.h"
 #include "world/map.h"
 #include "world/park.h"
+#include "world/ParkStatistics.h"
 #include "world/scenery.h"
 #include "world/sprite.h"
 
@@ -294,6 +295,7 @@ static void cheat_set_guest_parameter(sint32 parameter, sint32 value)
                 peep->peep_flags &= ~PEEP_FLAGS_ANGRY;
                 peep->angriness = 0;
             }
+            park_statistics_update_peep(peep);
             break;
         case GUEST_PARAMETER_ENERGY:
             peep->energy = value;
@@ -18,11 +18,13 @@
 #include "CommandLine.hpp"
 
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator *argEnumerator);
+static exitcode_t HandleBenchGfxSuite(CommandLineArgEnumerator *argEnumerator);
 
 const CommandLineCommand CommandLine::BenchGfxCommands[]
 {
     // Main commands
-    DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx),
+    DefineCommand("",      "<file> [iterations count]",                nullptr, HandleBenchGfx     ),
+    DefineCommand("suite", "<file> [iterations count] [json output]", nullptr, HandleBenchGfxSuite),
     CommandTableEnd
 };
 
@@ -36,3 +38,14 @@ static exitcode_t HandleBenchGfx(CommandLineArgEnumerator *argEnumerator)
     }
     return EXITCODE_OK;
 }
+
+static exitcode_t HandleBenchGfxSuite(CommandLineArgEnumerator *argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    sint32 result = cmdline_for_gfxbench_suite(argv, argc);
+    if (result < 0) {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
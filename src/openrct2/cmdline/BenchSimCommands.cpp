@@ -0,0 +1,117 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <chrono>
+#include <exception>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../core/Memory.hpp"
+#include "CommandLine.hpp"
+
+#include "../game.h"
+#include "../intro.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSimCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [ticks]", nullptr, HandleBenchSim),
+    CommandTableEnd
+};
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    if (argc != 1 && argc != 2)
+    {
+        Console::Error::WriteLine("Usage: openrct2 benchsim <file> [<ticks>]");
+        return EXITCODE_FAIL;
+    }
+
+    const char * inputPath = argv[0];
+    sint32 tickCount = 10000;
+    if (argc == 2)
+    {
+        tickCount = atoi(argv[1]);
+        if (tickCount <= 0)
+        {
+            Console::Error::WriteLine("Tick count must be a positive number.");
+            return EXITCODE_FAIL;
+        }
+    }
+
+    exitcode_t result = EXITCODE_FAIL;
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (context->Initialise())
+    {
+        bool loaded = false;
+        try
+        {
+            loaded = context->LoadParkFromFile(inputPath);
+        }
+        catch (const std::exception &ex)
+        {
+            Console::Error::WriteLine("Failed to load '%s'", inputPath);
+            Console::Error::WriteLine("%s", ex.what());
+        }
+
+        if (loaded)
+        {
+            gIntroState = INTRO_STATE_NONE;
+            gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+            Memory::Set(gGameLogicStageTimes, 0, sizeof(gGameLogicStageTimes));
+            gGameLogicStageTimingEnabled = true;
+            gInUpdateCode = true;
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (sint32 i = 0; i < tickCount; i++)
+            {
+                game_logic_update();
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            gInUpdateCode = false;
+            gGameLogicStageTimingEnabled = false;
+
+            std::chrono::duration<double> duration = endTime - startTime;
+            double totalSeconds = duration.count();
+            Console::WriteLine("Simulating %d ticks took %.3f seconds (%.1f ticks/sec).",
+                               tickCount, totalSeconds, tickCount / totalSeconds);
+            Console::WriteLine();
+            Console::WriteLine("%-20s %12s %10s %8s", "Stage", "Total (ms)", "us/tick", "%");
+            for (sint32 stage = 0; stage < GAME_LOGIC_STAGE_COUNT; stage++)
+            {
+                double stageMs = gGameLogicStageTimes[stage] / 1000.0;
+                Console::WriteLine("%-20s %12.2f %10.2f %7.1f%%",
+                                   GameLogicStageNames[stage],
+                                   stageMs,
+                                   (double)gGameLogicStageTimes[stage] / tickCount,
+                                   stageMs / (totalSeconds * 10.0));
+            }
+            result = EXITCODE_OK;
+        }
+    }
+    delete context;
+    return result;
+}
@@ -198,6 +198,8 @@ namespace Config
             model->last_save_track_directory = reader->GetCString("last_track_directory", nullptr);
             model->window_limit = reader->GetSint32("window_limit", WINDOW_LIMIT_MAX);
             model->zoom_to_cursor = reader->GetBoolean("zoom_to_cursor", true);
+            model->multithreading = reader->GetBoolean("multithreading", false);
+            model->multithreaded_pathfinding = reader->GetBoolean("multithreaded_pathfinding", false);
             model->render_weather_effects = reader->GetBoolean("render_weather_effects", true);
             model->render_weather_gloom = reader->GetBoolean("render_weather_gloom", true);
             model->show_guest_purchases = reader->GetBoolean("show_guest_purchases", false);
@@ -268,6 +270,8 @@ namespace Config
         writer->WriteString("last_track_directory", model->last_save_track_directory);
         writer->WriteSint32("window_limit", model->window_limit);
         writer->WriteBoolean("zoom_to_cursor", model->zoom_to_cursor);
+        writer->WriteBoolean("multithreading", model->multithreading);
+        writer->WriteBoolean("multithreaded_pathfinding", model->multithreaded_pathfinding);
         writer->WriteBoolean("render_weather_effects", model->render_weather_effects);
         writer->WriteBoolean("render_weather_gloom", model->render_weather_gloom);
         writer->WriteBoolean("show_guest_purchases", model->show_guest_purchases);
@@ -87,6 +87,8 @@ typedef struct GeneralConfiguration
     bool        scenario_hide_mega_park;
     bool        steam_overlay_pause;
     bool        show_real_names_of_guests;
+    bool        multithreading;
+    bool        multithreaded_pathfinding;
 
     bool        confirmation_prompt;
     sint32      load_save_sort;
@@ -17,37 +17,40 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "../common.h"
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
+#include "JobPool.hpp"
+#include "Memory.hpp"
 #include "Path.hpp"
 
 template<typename TItem>
 class FileIndex
 {
 private:
-    struct DirectoryStats
+    struct ScannedFile
     {
-        uint32 TotalFiles = 0;
-        uint64 TotalFileSize = 0;
-        uint32 FileDateModifiedChecksum = 0;
-        uint32 PathChecksum = 0;
+        std::string Path;
+        uint64      Size = 0;
+        uint64      LastModified = 0;
     };
 
-    struct ScanResult
+    /**
+     * The item created for a file, which may be empty if the file could not be read.
+     * Entries are kept for those as well so unreadable files are not read again on every start.
+     */
+    struct FileEntry
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
-            : Stats(stats),
-              Files(files)
-        {
-        }
+        bool    Valid = false;
+        bool    HasItem = false;
+        TItem   Item = TItem();
     };
 
     struct FileIndexHeader
@@ -57,12 +60,14 @@ private:
         uint8           VersionA = 0;
         uint8           VersionB = 0;
         uint16          LanguageId = 0;
-        DirectoryStats  Stats;
-        uint32          NumItems = 0;
+        uint32          NumEntries = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8 FILE_INDEX_VERSION = 4;
+    static constexpr uint8 FILE_INDEX_VERSION = 5;
+
+    // Files are handed to the worker threads in batches of this size
+    static constexpr size_t FILES_PER_TASK = 16;
 
     std::string const _name;
     uint32 const _magicNumber;
@@ -101,37 +106,28 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files whose size and modification time
+     * match their index entry are loaded from the index, all other files are read again.
      */
     std::vector<TItem> LoadOrBuild() const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(scanResult);
-        }
-        return items;
+        auto files = Scan();
+        auto entries = std::vector<FileEntry>(files.size());
+        size_t numIndexEntries = ReadIndexFile(files, entries);
+        return Build(files, entries, numIndexEntries);
     }
 
     std::vector<TItem> Rebuild() const
     {
-        auto scanResult = Scan();
-        auto items = Build(scanResult);
-        return items;
+        auto files = Scan();
+        auto entries = std::vector<FileEntry>(files.size());
+        return Build(files, entries, 0);
     }
 
 protected:
     /**
      * Loads the given file and creates the item representing the data to store in the index.
+     * Called from worker threads, so it must not modify any shared state.
      * TODO Use std::optional when C++17 is available.
      */
     virtual std::tuple<bool, TItem> Create(const std::string &path) const abstract;
@@ -147,11 +143,10 @@ protected:
     virtual TItem Deserialise(IStream * stream) const abstract;
 
 private:
-    ScanResult Scan() const
+    std::vector<ScannedFile> Scan() const
     {
-        DirectoryStats stats;
-        std::vector<std::string> files;
-        for (const auto directory : SearchPaths)
+        std::vector<ScannedFile> files;
+        for (const auto &directory : SearchPaths)
         {
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), directory.c_str());
 
@@ -160,75 +155,171 @@ private:
             while (scanner->Next())
             {
                 auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
-                files.push_back(path);
 
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^=
-                    (uint32)(fileInfo->LastModified >> 32) ^
-                    (uint32)(fileInfo->LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                ScannedFile file;
+                file.Path = std::string(scanner->GetPath());
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                files.push_back(file);
             }
             delete scanner;
         }
-        return ScanResult(stats, files);
+        return files;
     }
 
-    std::vector<TItem> Build(const ScanResult &scanResult) const
+    /**
+     * Creates the entries that were not loaded from the index and writes the index if anything changed.
+     * @param numIndexEntries The number of entries in the index file that was read.
+     */
+    std::vector<TItem> Build(const std::vector<ScannedFile> &files, std::vector<FileEntry> &entries, size_t numIndexEntries) const
     {
-        std::vector<TItem> items;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
-        auto startTime = std::chrono::high_resolution_clock::now();
-        for (auto filePath : scanResult.Files)
+        std::vector<size_t> changedFiles;
+        for (size_t i = 0; i < entries.size(); i++)
         {
-            log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
-            auto item = Create(filePath);
-            if (std::get<0>(item))
+            if (!entries[i].Valid)
             {
-                items.push_back(std::get<1>(item));
+                changedFiles.push_back(i);
             }
         }
 
-        WriteIndexFile(scanResult.Stats, items);
+        size_t numReusedEntries = entries.size() - changedFiles.size();
+        if (changedFiles.size() > 0 || numReusedEntries != numIndexEntries)
+        {
+            if (numReusedEntries == 0)
+            {
+                Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+            }
+            else
+            {
+                Console::WriteLine("Updating %s (%zu items, %zu new or changed)", _name.c_str(), files.size(), changedFiles.size());
+            }
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            CreateEntries(files, changedFiles, entries);
+            WriteIndexFile(files, entries);
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = (std::chrono::duration<float>)(endTime - startTime);
+            Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        }
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = (std::chrono::duration<float>)(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        std::vector<TItem> items;
+        for (const auto &entry : entries)
+        {
+            if (entry.HasItem)
+            {
+                items.push_back(entry.Item);
+            }
+        }
         return items;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(const DirectoryStats &stats) const
+    /**
+     * Creates the entries of the given files, spread over a pool of worker threads.
+     */
+    void CreateEntries(const std::vector<ScannedFile> &files, const std::vector<size_t> &fileIndices, std::vector<FileEntry> &entries) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        auto createEntries = [this, &files, &fileIndices, &entries](size_t begin, size_t end) -> void
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const auto &path = files[fileIndices[i]].Path;
+                auto &entry = entries[fileIndices[i]];
+                log_verbose("FileIndex:Indexing '%s'", path.c_str());
+                try
+                {
+                    auto item = Create(path);
+                    entry.HasItem = std::get<0>(item);
+                    entry.Item = std::get<1>(item);
+                }
+                catch (const std::exception &e)
+                {
+                    Console::Error::WriteLine("Unable to index '%s'.", path.c_str());
+                    Console::Error::WriteLine("%s", e.what());
+                }
+                entry.Valid = true;
+            }
+        };
+
+        if (fileIndices.size() <= FILES_PER_TASK)
+        {
+            createEntries(0, fileIndices.size());
+            return;
+        }
+
+        // Each task writes to its own entries, so no locking is needed
+        auto jobPool = std::make_unique<JobPool>();
+        for (size_t begin = 0; begin < fileIndices.size(); begin += FILES_PER_TASK)
+        {
+            size_t end = Math::Min(begin + FILES_PER_TASK, fileIndices.size());
+            jobPool->AddTask([&createEntries, begin, end]() -> void
+            {
+                createEntries(begin, end);
+            });
+        }
+        jobPool->Join();
+    }
+
+    /**
+     * Reads the entries of the index file that are still up to date into the entries of the scanned files.
+     * @returns The number of entries in the index file.
+     */
+    size_t ReadIndexFile(const std::vector<ScannedFile> &files, std::vector<FileEntry> &entries) const
+    {
+        size_t numIndexEntries = 0;
         try
         {
             log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
             auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
 
-            // Read header, check if we need to re-scan
+            // Read header, any difference means every file needs to be read again
             auto header = fs.ReadValue<FileIndexHeader>();
             if (header.HeaderSize == sizeof(FileIndexHeader) &&
                 header.MagicNumber == _magicNumber &&
                 header.VersionA == FILE_INDEX_VERSION &&
                 header.VersionB == _version &&
-                header.LanguageId == gCurrentLanguage &&
-                header.Stats.TotalFiles == stats.TotalFiles &&
-                header.Stats.TotalFileSize == stats.TotalFileSize &&
-                header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum &&
-                header.Stats.PathChecksum == stats.PathChecksum)
+                header.LanguageId == gCurrentLanguage)
             {
-                // Directory is the same, just read the saved items
-                for (uint32 i = 0; i < header.NumItems; i++)
+                std::unordered_map<std::string, size_t> fileIndices;
+                for (size_t i = 0; i < files.size(); i++)
                 {
-                    auto item = Deserialise(&fs);
-                    items.push_back(item);
+                    fileIndices[files[i].Path] = i;
+                }
+
+                numIndexEntries = header.NumEntries;
+                for (uint32 i = 0; i < header.NumEntries; i++)
+                {
+                    utf8 * pathString = fs.ReadString();
+                    auto path = std::string(pathString);
+                    Memory::Free(pathString);
+                    auto size = fs.ReadValue<uint64>();
+                    auto lastModified = fs.ReadValue<uint64>();
+                    auto hasItem = fs.ReadValue<uint8>() != 0;
+                    auto itemLength = fs.ReadValue<uint32>();
+                    auto itemPosition = fs.GetPosition();
+
+                    auto it = fileIndices.find(path);
+                    if (it != fileIndices.end())
+                    {
+                        const auto &file = files[it->second];
+                        auto &entry = entries[it->second];
+                        if (file.Size == size && file.LastModified == lastModified && !entry.Valid)
+                        {
+                            // Only mark the entry valid once the item has been read in full
+                            TItem item = TItem();
+                            if (hasItem)
+                            {
+                                item = Deserialise(&fs);
+                            }
+                            entry.Item = std::move(item);
+                            entry.HasItem = hasItem;
+                            entry.Valid = true;
+                        }
+                    }
+
+                    // Skip items that were not deserialised
+                    fs.SetPosition(itemPosition + itemLength);
                 }
-                loadedItems = true;
             }
             else
             {
@@ -239,31 +330,49 @@ private:
         {
             Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
             Console::Error::WriteLine("%s", e.what());
+
+            // Entries read before the error are kept, the rest of the files are read again
+            numIndexEntries = 0;
         }
-        return std::make_tuple(loadedItems, items);
+        return numIndexEntries;
     }
 
-    void WriteIndexFile(const DirectoryStats &stats, const std::vector<TItem> &items) const
+    void WriteIndexFile(const std::vector<ScannedFile> &files, const std::vector<FileEntry> &entries) const
     {
         try
         {
             log_verbose("FileIndex:Writing index: '%s'", _indexPath.c_str());
             auto fs = FileStream(_indexPath, FILE_MODE_WRITE);
-    
+
             // Write header
             FileIndexHeader header;
             header.MagicNumber = _magicNumber;
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = gCurrentLanguage;
-            header.Stats = stats;
-            header.NumItems = (uint32)items.size();
+            header.NumEntries = (uint32)files.size();
             fs.WriteValue(header);
-    
-            // Write items
-            for (const auto item : items)
+
+            // Write an entry for every file, items are prefixed with their length so they can be skipped
+            for (size_t i = 0; i < files.size(); i++)
             {
-                Serialise(&fs, item);
+                const auto &file = files[i];
+                const auto &entry = entries[i];
+                fs.WriteString(file.Path);
+                fs.WriteValue<uint64>(file.Size);
+                fs.WriteValue<uint64>(file.LastModified);
+                fs.WriteValue<uint8>(entry.HasItem ? 1 : 0);
+
+                uint64 lengthPosition = fs.GetPosition();
+                fs.WriteValue<uint32>(0);
+                if (entry.HasItem)
+                {
+                    Serialise(&fs, entry.Item);
+                }
+                uint64 endPosition = fs.GetPosition();
+                fs.SetPosition(lengthPosition);
+                fs.WriteValue<uint32>((uint32)(endPosition - lengthPosition - sizeof(uint32)));
+                fs.SetPosition(endPosition);
             }
         }
         catch (const std::exception &e)
@@ -272,19 +381,4 @@ private:
             Console::Error::WriteLine("%s", e.what());
         }
     }
-
-    static uint32 GetPathChecksum(const std::string &path)
-    {
-        uint32 hash = 0xD8430DED;
-        for (const utf8 * ch = path.c_str(); *ch != '\0'; ch++)
-        {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
-        }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
-    }
 };
@@ -0,0 +1,95 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "IStream.hpp"
+#include "MappedFile.h"
+#include "String.hpp"
+
+#include "../util/util.h"
+
+MappedFile::MappedFile(const std::string &path)
+{
+#ifdef _WIN32
+    auto pathW = utf8_to_widechar(path.c_str());
+    HANDLE hFile = CreateFileW(pathW, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    free(pathW);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    LARGE_INTEGER fileSize;
+    HANDLE hMapping = nullptr;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 && (uint64)fileSize.QuadPart <= SIZE_MAX)
+    {
+        hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    }
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+    {
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+
+    // The view keeps the mapping alive after its handle is closed
+    _data = (uint8 *)MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(hMapping);
+    if (_data == nullptr)
+    {
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+    _length = (size_t)fileSize.QuadPart;
+#else
+    sint32 fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    struct stat statInfo;
+    void * data = MAP_FAILED;
+    if (fstat(fd, &statInfo) == 0 && statInfo.st_size > 0 && (uint64)statInfo.st_size <= SIZE_MAX)
+    {
+        data = mmap(nullptr, (size_t)statInfo.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+    _data = (uint8 *)data;
+    _length = (size_t)statInfo.st_size;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(_data, _length);
+#endif
+}
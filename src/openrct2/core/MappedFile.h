@@ -0,0 +1,46 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <string>
+#include "../common.h"
+
+/**
+ * A whole file mapped into memory and paged in by the OS as it is read.
+ * Pages are mapped copy-on-write, so writes to the data never reach the file.
+ * Throws IOException if the file cannot be opened or mapped.
+ */
+class MappedFile final
+{
+private:
+    uint8 * _data   = nullptr;
+    size_t  _length = 0;
+
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    uint8 * GetData() const { return _data; }
+    size_t GetLength() const { return _length; }
+};
+
+#endif
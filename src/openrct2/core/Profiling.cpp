@@ -0,0 +1,195 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include "../platform/platform.h"
+#include "Console.hpp"
+#include "Json.hpp"
+#include "Profiling.h"
+
+enum class ProfilingEventType : uint8
+{
+    Timer,
+    Counter,
+};
+
+struct ProfilingEvent
+{
+    const char *       Name;
+    uint64             Time;
+    uint64             Duration;
+    sint64             Value;
+    uint32             ThreadId;
+    ProfilingEventType Type;
+};
+
+static ProfilingEvent   _events[PROFILING_MAX_EVENTS];
+static size_t           _eventHead;
+static size_t           _eventCount;
+static std::mutex       _eventsMutex;
+static std::atomic<uint32> _nextThreadId;
+// Read by worker threads while the console switches profiling on and off
+static std::atomic<bool> _profilingEnabled { false };
+
+static uint32 GetThreadId()
+{
+    static thread_local uint32 threadId = ++_nextThreadId;
+    return threadId;
+}
+
+static void AddEvent(const ProfilingEvent &e)
+{
+    std::lock_guard<std::mutex> lock(_eventsMutex);
+    _events[_eventHead] = e;
+    _eventHead = (_eventHead + 1) % PROFILING_MAX_EVENTS;
+    if (_eventCount < PROFILING_MAX_EVENTS)
+    {
+        _eventCount++;
+    }
+}
+
+extern "C"
+{
+    void profiling_start()
+    {
+        profiling_clear();
+        _profilingEnabled = true;
+    }
+
+    void profiling_stop()
+    {
+        _profilingEnabled = false;
+    }
+
+    void profiling_clear()
+    {
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        _eventHead = 0;
+        _eventCount = 0;
+    }
+
+    bool profiling_is_enabled()
+    {
+        return _profilingEnabled;
+    }
+
+    size_t profiling_get_event_count()
+    {
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        return _eventCount;
+    }
+
+    uint64 profiling_begin()
+    {
+        if (!_profilingEnabled)
+        {
+            return 0;
+        }
+        return platform_get_ticks_precise();
+    }
+
+    void profiling_end(const char * name, uint64 startTime)
+    {
+        if (_profilingEnabled && startTime != 0)
+        {
+            profiling_record(name, startTime, platform_get_ticks_precise());
+        }
+    }
+
+    void profiling_record(const char * name, uint64 startTime, uint64 endTime)
+    {
+        if (_profilingEnabled)
+        {
+            ProfilingEvent e;
+            e.Name = name;
+            e.Time = startTime;
+            e.Duration = endTime - startTime;
+            e.Value = 0;
+            e.ThreadId = GetThreadId();
+            e.Type = ProfilingEventType::Timer;
+            AddEvent(e);
+        }
+    }
+
+    void profiling_counter(const char * name, sint64 value)
+    {
+        if (_profilingEnabled)
+        {
+            ProfilingEvent e;
+            e.Name = name;
+            e.Time = platform_get_ticks_precise();
+            e.Duration = 0;
+            e.Value = value;
+            e.ThreadId = GetThreadId();
+            e.Type = ProfilingEventType::Counter;
+            AddEvent(e);
+        }
+    }
+
+    /**
+     * Writes the recorded events in the Chrome trace event format, which can be
+     * viewed with chrome://tracing.
+     */
+    bool profiling_export_chrome_trace(const utf8 * path)
+    {
+        json_t * jsonEvents = json_array();
+        {
+            std::lock_guard<std::mutex> lock(_eventsMutex);
+            size_t first = (_eventHead + PROFILING_MAX_EVENTS - _eventCount) % PROFILING_MAX_EVENTS;
+            for (size_t i = 0; i < _eventCount; i++)
+            {
+                const ProfilingEvent &e = _events[(first + i) % PROFILING_MAX_EVENTS];
+                json_t * jsonEvent = json_object();
+                json_object_set_new(jsonEvent, "name", json_string(e.Name));
+                json_object_set_new(jsonEvent, "pid", json_integer(1));
+                json_object_set_new(jsonEvent, "tid", json_integer(e.ThreadId));
+                json_object_set_new(jsonEvent, "ts", json_integer((json_int_t)e.Time));
+                if (e.Type == ProfilingEventType::Timer)
+                {
+                    json_object_set_new(jsonEvent, "ph", json_string("X"));
+                    json_object_set_new(jsonEvent, "dur", json_integer((json_int_t)e.Duration));
+                }
+                else
+                {
+                    json_t * jsonArgs = json_object();
+                    json_object_set_new(jsonArgs, "value", json_integer(e.Value));
+                    json_object_set_new(jsonEvent, "ph", json_string("C"));
+                    json_object_set_new(jsonEvent, "args", jsonArgs);
+                }
+                json_array_append_new(jsonEvents, jsonEvent);
+            }
+        }
+
+        json_t * jsonTrace = json_object();
+        json_object_set_new(jsonTrace, "traceEvents", jsonEvents);
+        json_object_set_new(jsonTrace, "displayTimeUnit", json_string("ms"));
+
+        bool result = true;
+        try
+        {
+            Json::WriteToFile(path, jsonTrace);
+        }
+        catch (const std::exception &ex)
+        {
+            Console::Error::WriteLine("Unable to write profile: %s", ex.what());
+            result = false;
+        }
+        json_decref(jsonTrace);
+        return result;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "../common.h"
+
+// Number of events kept in the ring buffer, older events are overwritten
+#define PROFILING_MAX_EVENTS (1 << 16)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    void profiling_start();
+    void profiling_stop();
+    void profiling_clear();
+    bool profiling_is_enabled();
+    size_t profiling_get_event_count();
+
+    /**
+     * Returns the timestamp to pass to profiling_end, or 0 if profiling is disabled.
+     */
+    uint64 profiling_begin();
+    void profiling_end(const char * name, uint64 startTime);
+    void profiling_record(const char * name, uint64 startTime, uint64 endTime);
+    void profiling_counter(const char * name, sint64 value);
+
+    bool profiling_export_chrome_trace(const utf8 * path);
+#ifdef __cplusplus
+}
+
+namespace Profiling
+{
+    /**
+     * Records the lifetime of the object as a timed event when profiling is enabled.
+     * The name must be a string literal or otherwise outlive the profiling session.
+     */
+    class ScopedTimer final
+    {
+    private:
+        const char * _name;
+        uint64       _startTime;
+
+    public:
+        explicit ScopedTimer(const char * name)
+            : _name(name),
+              _startTime(profiling_begin())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            profiling_end(_name, _startTime);
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer & operator=(const ScopedTimer &) = delete;
+    };
+}
+
+// The line number makes the variable name unique, so several scopes can share a block
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) Profiling::ScopedTimer PROFILE_CONCAT(_profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION()  PROFILE_SCOPE(__func__)
+
+#endif
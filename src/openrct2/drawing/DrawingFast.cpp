@@ -16,8 +16,127 @@
 
 #pragma warning(disable : 4127) // conditional expression is constant
 
+#include "../util/util.h"
 #include "drawing.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define OPENRCT2_RLE_SIMD
+    #define OPENRCT2_TARGET_SSE2 __attribute__((target("sse2")))
+    #define OPENRCT2_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #define OPENRCT2_RLE_SIMD
+    #define OPENRCT2_TARGET_SSE2
+    #define OPENRCT2_TARGET_AVX2
+#endif
+
+// Runs shorter than this are drawn by the scalar loops, the kernels work on 16 destination pixels at a time
+#define RLE_KERNEL_MIN_PIXELS 16
+
+// Palettes are copied into a buffer with this much padding so that 32 bit gathers never read past the end
+#define RLE_PALETTE_PADDING 4
+
+/**
+ * Replaces count pixels with palette[source pixel]. The source may be the destination itself.
+ * The palette must be padded by RLE_PALETTE_PADDING bytes.
+ */
+using rle_remap_kernel = void (*)(uint8 * dst, const uint8 * src, const uint8 * palette, sint32 count);
+
+/**
+ * Copies every (1 << zoom_level)th pixel of a run. count is the number of source pixels that may be read.
+ * Returns the number of destination pixels written, the caller finishes the rest of the run.
+ */
+using rle_copy_kernel = sint32 (*)(uint8 * dst, const uint8 * src, sint32 count);
+
+struct rle_kernels
+{
+    rle_remap_kernel Remap = nullptr;
+    rle_copy_kernel  CopyZoomed[4] = { };
+};
+
+#ifdef OPENRCT2_RLE_SIMD
+
+OPENRCT2_TARGET_SSE2
+static sint32 rle_copy_zoom_1_sse2(uint8 * dst, const uint8 * src, sint32 count)
+{
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    sint32 written = 0;
+    for (; count >= 32; count -= 32, src += 32, dst += 16, written += 16)
+    {
+        __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)src), mask);
+        __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 16)), mask);
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(a, b));
+    }
+    return written;
+}
+
+OPENRCT2_TARGET_SSE2
+static sint32 rle_copy_zoom_2_sse2(uint8 * dst, const uint8 * src, sint32 count)
+{
+    const __m128i mask = _mm_set1_epi32(0x000000FF);
+    sint32 written = 0;
+    for (; count >= 64; count -= 64, src += 64, dst += 16, written += 16)
+    {
+        __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)src), mask);
+        __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 16)), mask);
+        __m128i c = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 32)), mask);
+        __m128i d = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 48)), mask);
+        __m128i ab = _mm_packs_epi32(a, b);
+        __m128i cd = _mm_packs_epi32(c, d);
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(ab, cd));
+    }
+    return written;
+}
+
+OPENRCT2_TARGET_AVX2
+static void rle_remap_avx2(uint8 * dst, const uint8 * src, const uint8 * palette, sint32 count)
+{
+    const __m256i mask = _mm256_set1_epi32(0x000000FF);
+    for (; count >= 16; count -= 16, src += 16, dst += 16)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+        __m256i indexLo = _mm256_cvtepu8_epi32(pixels);
+        __m256i indexHi = _mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8));
+        __m256i colourLo = _mm256_and_si256(_mm256_i32gather_epi32((const int *)palette, indexLo, 1), mask);
+        __m256i colourHi = _mm256_and_si256(_mm256_i32gather_epi32((const int *)palette, indexHi, 1), mask);
+
+        // packus works within 128 bit lanes, so the quarters need putting back in order before the final pack
+        __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(colourLo, colourHi), 0xD8);
+        __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+        _mm_storeu_si128((__m128i *)dst, bytes);
+    }
+    for (; count > 0; count--)
+    {
+        *dst++ = palette[*src++];
+    }
+}
+
+#endif // OPENRCT2_RLE_SIMD
+
+static rle_kernels rle_select_kernels()
+{
+    rle_kernels kernels;
+#ifdef OPENRCT2_RLE_SIMD
+    if (sse2_available())
+    {
+        kernels.CopyZoomed[1] = rle_copy_zoom_1_sse2;
+        kernels.CopyZoomed[2] = rle_copy_zoom_2_sse2;
+    }
+    if (avx2_available())
+    {
+        kernels.Remap = rle_remap_avx2;
+    }
+#endif
+    return kernels;
+}
+
+static const rle_kernels &rle_get_kernels()
+{
+    static const rle_kernels kernels = rle_select_kernels();
+    return kernels;
+}
+
 template<sint32 image_type, sint32 zoom_level>
 static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                                       uint8* RESTRICT dest_bits_pointer,
@@ -35,6 +154,18 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
     // Width of one screen line in the dest buffer
     sint32 line_width = (dpi->width >> zoom_level) + dpi->pitch;
 
+    const rle_kernels &kernels = rle_get_kernels();
+    rle_remap_kernel remapKernel = nullptr;
+    rle_copy_kernel copyKernel = kernels.CopyZoomed[zoom_level];
+    if (zoom_level == 0 && (image_type == IMAGE_TYPE_REMAP || image_type == IMAGE_TYPE_TRANSPARENT))
+    {
+        remapKernel = kernels.Remap;
+    }
+
+    // Only copied once a run is long enough to use the remap kernel
+    uint8 paddedPalette[256 + RLE_PALETTE_PADDING];
+    bool paddedPaletteReady = false;
+
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (source_y_start < 0)
     {
@@ -105,7 +236,20 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
 
             //Finally after all those checks, copy the image onto the drawing surface
             //If the image type is not a basic one we require to mix the pixels
-            if (image_type & IMAGE_TYPE_REMAP)  // palette controlled images
+            if (remapKernel != nullptr && numPixels >= RLE_KERNEL_MIN_PIXELS)
+            {
+                if (!paddedPaletteReady)
+                {
+                    memcpy(paddedPalette, palette_pointer, 256);
+                    memset(paddedPalette + 256, 0, RLE_PALETTE_PADDING);
+                    paddedPaletteReady = true;
+                }
+
+                // The glass blend looks up the pixel already on the surface
+                const uint8 * remapSrc = (image_type & IMAGE_TYPE_REMAP) ? copySrc : copyDest;
+                remapKernel(copyDest, remapSrc, paddedPalette, numPixels);
+            }
+            else if (image_type & IMAGE_TYPE_REMAP)  // palette controlled images
             {
                 for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
                 {
@@ -139,7 +283,15 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                 }
                 else
                 {
-                    for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
+                    sint32 j = 0;
+                    if (copyKernel != nullptr && numPixels > 0)
+                    {
+                        sint32 written = copyKernel(copyDest, copySrc, numPixels);
+                        j = written << zoom_level;
+                        copySrc += j;
+                        copyDest += written;
+                    }
+                    for (; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
                         *copyDest = *copySrc;
                 }
             }
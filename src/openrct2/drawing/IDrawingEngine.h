@@ -35,6 +35,11 @@ enum DRAWING_ENGINE_FLAGS
      * Whether or not the engine will only draw changed blocks of the screen each frame.
      */
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
+
+    /**
+     * Whether or not sprites can be drawn to disjoint areas of the screen from several threads at once.
+     */
+    DEF_PARALLEL_DRAWING = 1 << 1,
 };
 
 #ifdef __cplusplus
@@ -46,6 +51,16 @@ namespace OpenRCT2 { namespace Drawing
 {
     interface IDrawingContext;
 
+    /**
+     * How much of the screen was repainted in the last frame, for engines with DEF_DIRTY_OPTIMISATIONS.
+     */
+    struct DrawingEngineFrameStats
+    {
+        uint32 DirtyBlocks;     // Blocks invalidated since the previous frame
+        uint32 PaintedBlocks;   // Blocks repainted, including clean blocks merged into a larger region
+        uint32 PaintedRegions;  // Separate repaints of the windows
+    };
+
     interface IDrawingEngine
     {
         virtual ~IDrawingEngine() { }
@@ -70,6 +85,8 @@ namespace OpenRCT2 { namespace Drawing
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32 image) abstract;
+
+        virtual DrawingEngineFrameStats GetFrameStats() abstract;
     };
 
     interface IRainDrawer
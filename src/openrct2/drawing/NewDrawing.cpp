@@ -24,9 +24,11 @@
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 #include "NewDrawing.h"
+#include "SpriteCache.h"
 
 #include "../config/Config.h"
 #include "../drawing/drawing.h"
+#include "../game.h"
 #include "../localisation/string_ids.h"
 #include "../platform/platform.h"
 
@@ -194,8 +196,20 @@ extern "C"
         return result;
     }
 
+    bool drawing_engine_supports_parallel_drawing()
+    {
+        bool result = false;
+        if (_drawingEngine != nullptr)
+        {
+            result = (_drawingEngine->GetFlags() & DEF_PARALLEL_DRAWING);
+        }
+        return result;
+    }
+
     void drawing_engine_invalidate_image(uint32 image)
     {
+        // Software drawing is also used with other engines (e.g. for giant screenshots), so always evict
+        sprite_cache_invalidate_image(image);
         if (_drawingEngine != nullptr)
         {
             _drawingEngine->InvalidateImage(image);
@@ -212,7 +226,7 @@ extern "C"
 
     void gfx_set_dirty_blocks(sint16 left, sint16 top, sint16 right, sint16 bottom)
     {
-        if (_drawingEngine != nullptr)
+        if (_drawingEngine != nullptr && !gInTurboUpdate)
         {
             _drawingEngine->Invalidate(left, top, right, bottom);
         }
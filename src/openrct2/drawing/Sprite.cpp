@@ -20,6 +20,7 @@
 #include "../Context.h"
 #include "../core/File.h"
 #include "../core/FileStream.hpp"
+#include "../core/MappedFile.h"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/Util.hpp"
@@ -32,6 +33,7 @@
 #include "../rct2/addresses.h"
 #include "../util/util.h"
 #include "drawing.h"
+#include "SpriteCache.h"
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Ui;
@@ -74,9 +76,8 @@ static inline uint32 rctc_to_rct2_index(uint32 image)
     else throw Exception("Invalid RCTC g1.dat file");
 }
 
-static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc, rct_g1_element *elements)
+static void convert_gxdat(const rct_g1_element_32bit * g1Elements32, size_t count, bool is_rctc, rct_g1_element *elements)
 {
-    auto g1Elements32 = stream->ReadArray<rct_g1_element_32bit>(count);
     if (is_rctc)
     {
         // Process RCTC's g1.dat file
@@ -153,9 +154,62 @@ static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc,
             elements[i].zoomed_offset = src.zoomed_offset;
         }
     }
+}
+
+static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc, rct_g1_element *elements)
+{
+    auto g1Elements32 = stream->ReadArray<rct_g1_element_32bit>(count);
+    convert_gxdat(g1Elements32, count, is_rctc, elements);
     Memory::Free(g1Elements32);
 }
 
+/**
+ * Maps a g1.dat style file: a header, the element headers and then the element data.
+ * Returns nullptr if the file cannot be mapped or is too short, so that it can be read the usual way instead.
+ */
+static std::unique_ptr<MappedFile> map_gxdat(const std::string &path, rct_g1_header * header)
+{
+    std::unique_ptr<MappedFile> file;
+    try
+    {
+        file = std::make_unique<MappedFile>(path);
+    }
+    catch (const IOException &)
+    {
+        return nullptr;
+    }
+
+    if (file->GetLength() < sizeof(rct_g1_header))
+    {
+        return nullptr;
+    }
+    memcpy(header, file->GetData(), sizeof(rct_g1_header));
+
+    uint64 requiredLength = sizeof(rct_g1_header) + (uint64)header->num_entries * sizeof(rct_g1_element_32bit) + header->total_size;
+    if (file->GetLength() < requiredLength)
+    {
+        return nullptr;
+    }
+    return file;
+}
+
+/**
+ * Converts the element headers and returns the element data. With a mapped file the data is left in the mapping
+ * to be paged in as sprites are drawn, otherwise it is read from the stream into a buffer owned by the caller.
+ */
+static uint8 * load_gxdat_elements(MappedFile * mappedFile, IStream * stream, const rct_g1_header &header, bool is_rctc, rct_g1_element * elements)
+{
+    if (mappedFile != nullptr)
+    {
+        auto g1Elements32 = (const rct_g1_element_32bit *)(mappedFile->GetData() + sizeof(rct_g1_header));
+        convert_gxdat(g1Elements32, header.num_entries, is_rctc, elements);
+        return (uint8 *)(g1Elements32 + header.num_entries);
+    }
+
+    read_and_convert_gxdat(stream, header.num_entries, is_rctc, elements);
+    return stream->ReadArray<uint8>(header.total_size);
+}
+
 extern "C"
 {
     static void *   _g1Buffer = nullptr;
@@ -163,6 +217,11 @@ extern "C"
     static rct_gx   _csg = { 0 };
     static bool     _csgLoaded = false;
 
+    // Set instead of the buffers above when the data files are memory mapped
+    static std::unique_ptr<MappedFile> _g1File;
+    static std::unique_ptr<MappedFile> _g2File;
+    static std::unique_ptr<MappedFile> _csgFile;
+
     #ifdef NO_RCT2
         rct_g1_element * g1Elements = nullptr;
     #else
@@ -182,8 +241,14 @@ extern "C"
         try
         {
             auto path = Path::Combine(env->GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            rct_g1_header header = fs.ReadValue<rct_g1_header>();
+            rct_g1_header header;
+            auto mappedFile = map_gxdat(path, &header);
+            std::unique_ptr<FileStream> fs;
+            if (mappedFile == nullptr)
+            {
+                fs = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+                header = fs->ReadValue<rct_g1_header>();
+            }
 
             if (header.num_entries < SPR_G1_END)
             {
@@ -195,16 +260,21 @@ extern "C"
             g1Elements = Memory::AllocateArray<rct_g1_element>(324206);
 #endif
             bool is_rctc = header.num_entries == SPR_RCTC_G1_END;
-            read_and_convert_gxdat(&fs, header.num_entries, is_rctc, g1Elements);
+            uint8 * data = load_gxdat_elements(mappedFile.get(), fs.get(), header, is_rctc, g1Elements);
             gTinyFontAntiAliased = is_rctc;
-
-            // Read element data
-            _g1Buffer = fs.ReadArray<uint8>(header.total_size);
+            if (mappedFile != nullptr)
+            {
+                _g1File = std::move(mappedFile);
+            }
+            else
+            {
+                _g1Buffer = data;
+            }
 
             // Fix entry data offsets
             for (uint32 i = 0; i < header.num_entries; i++)
             {
-                g1Elements[i].offset += (uintptr_t)_g1Buffer;
+                g1Elements[i].offset += (uintptr_t)data;
             }
             return true;
         }
@@ -222,6 +292,8 @@ extern "C"
 
     void gfx_unload_g1()
     {
+        sprite_cache_clear();
+        _g1File = nullptr;
         SafeFree(_g1Buffer);
     #ifdef NO_RCT2
         SafeFree(g1Elements);
@@ -230,13 +302,25 @@ extern "C"
 
     void gfx_unload_g2()
     {
+        sprite_cache_clear();
         SafeFree(_g2.elements);
+        if (_g2File != nullptr)
+        {
+            _g2File = nullptr;
+            _g2.data = nullptr;
+        }
         SafeFree(_g2.data);
     }
 
     void gfx_unload_csg()
     {
+        sprite_cache_clear();
         SafeFree(_csg.elements);
+        if (_csgFile != nullptr)
+        {
+            _csgFile = nullptr;
+            _csg.data = nullptr;
+        }
         SafeFree(_csg.data);
     }
 
@@ -250,15 +334,18 @@ extern "C"
         safe_strcat_path(path, "g2.dat", MAX_PATH);
         try
         {
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            _g2.header = fs.ReadValue<rct_g1_header>();
+            auto mappedFile = map_gxdat(path, &_g2.header);
+            std::unique_ptr<FileStream> fs;
+            if (mappedFile == nullptr)
+            {
+                fs = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+                _g2.header = fs->ReadValue<rct_g1_header>();
+            }
 
-            // Read element headers
+            // Read element headers and data
             _g2.elements = Memory::AllocateArray<rct_g1_element>(_g2.header.num_entries);
-            read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements);
-
-            // Read element data
-            _g2.data = fs.ReadArray<uint8>(_g2.header.total_size);
+            _g2.data = load_gxdat_elements(mappedFile.get(), fs.get(), _g2.header, false, _g2.elements);
+            _g2File = std::move(mappedFile);
 
             // Fix entry data offsets
             for (uint32 i = 0; i < _g2.header.num_entries; i++)
@@ -332,9 +419,20 @@ extern "C"
         try
         {
             auto fileHeader = FileStream(pathHeaderPath.get(), FILE_MODE_OPEN);
-            auto fileData = FileStream(pathDataPath.get(), FILE_MODE_OPEN);
             size_t fileHeaderSize = fileHeader.GetLength();
-            size_t fileDataSize = fileData.GetLength();
+
+            // The data is paged in as sprites are drawn when the file can be mapped
+            std::unique_ptr<MappedFile> mappedData;
+            std::unique_ptr<FileStream> fileData;
+            try
+            {
+                mappedData = std::make_unique<MappedFile>(pathDataPath.get());
+            }
+            catch (const IOException &)
+            {
+                fileData = std::make_unique<FileStream>(pathDataPath.get(), FILE_MODE_OPEN);
+            }
+            size_t fileDataSize = mappedData != nullptr ? mappedData->GetLength() : (size_t)fileData->GetLength();
 
             _csg.header.num_entries = (uint32)(fileHeaderSize / sizeof(rct_g1_element_32bit));
             _csg.header.total_size = (uint32)fileDataSize;
@@ -344,7 +442,15 @@ extern "C"
             read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements);
 
             // Read element data
-            _csg.data = fileData.ReadArray<uint8>(_csg.header.total_size);
+            if (mappedData != nullptr)
+            {
+                _csg.data = mappedData->GetData();
+                _csgFile = std::move(mappedData);
+            }
+            else
+            {
+                _csg.data = fileData->ReadArray<uint8>(_csg.header.total_size);
+            }
 
             // Fix entry data offsets
             for (uint32 i = 0; i < _csg.header.num_entries; i++)
@@ -469,13 +575,23 @@ extern "C"
             return g1Elements[palette_offset].offset;
         }
         else {
-            uint8* palette_pointer = gPeepPalette;
+            // Remapped palettes are built in per thread copies as sprites may be drawn from several threads
+            static thread_local uint8 peepPalette[256];
+            static thread_local uint8 otherPalette[256];
+            static thread_local bool palettesInitialised = false;
+            if (!palettesInitialised) {
+                memcpy(peepPalette, gPeepPalette, sizeof(peepPalette));
+                memcpy(otherPalette, gOtherPalette, sizeof(otherPalette));
+                palettesInitialised = true;
+            }
+
+            uint8* palette_pointer = peepPalette;
 
             uint32 primary_offset = palette_to_g1_offset[(image_id >> 19) & 0x1F];
             uint32 secondary_offset = palette_to_g1_offset[(image_id >> 24) & 0x1F];
 
             if (!(image_type & IMAGE_TYPE_REMAP)) {
-                palette_pointer = gOtherPalette;
+                palette_pointer = otherPalette;
     #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
                 assert(tertiary_colour < PALETTE_TO_G1_OFFSET_COUNT);
     #endif // DEBUG_LEVEL_2
@@ -661,6 +777,10 @@ extern "C"
         if (g1_source->flags & G1_FLAG_RLE_COMPRESSION){
             // We have to use a different method to move the source pointer for
             // rle encoded sprites so that will be handled within this function
+            if (zoom_level != 0 && sprite_cache_draw_rle(dpi, image_element, g1_source, dest_pointer, palette_pointer, image_type, source_start_y, height, source_start_x, width))
+            {
+                return;
+            }
             gfx_rle_sprite_to_buffer(g1_source->offset, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
             return;
         }
@@ -0,0 +1,330 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "SpriteCache.h"
+
+// The cache is split so that viewport columns drawn on different threads rarely wait on each other
+constexpr sint32 SPRITE_CACHE_SHARD_COUNT = 8;
+
+// Rough cost of the bookkeeping for each entry, counted against the budget along with the pixel data
+constexpr size_t SPRITE_CACHE_ENTRY_OVERHEAD = 96;
+
+struct SpriteCacheEntry
+{
+    uint32              Key;
+    const uint8 *       Source;
+    sint32              Height;
+    std::vector<uint8>  Data;
+
+    size_t GetSize() const
+    {
+        return Data.capacity() + SPRITE_CACHE_ENTRY_OVERHEAD;
+    }
+};
+
+using SpriteCacheEntryPtr = std::shared_ptr<const SpriteCacheEntry>;
+
+struct SpriteCacheShard
+{
+    std::mutex                                                          Mutex;
+    std::list<SpriteCacheEntryPtr>                                      Entries; // Most recently drawn first
+    std::unordered_map<uint32, std::list<SpriteCacheEntryPtr>::iterator> Lookup;
+    size_t                                                              Bytes = 0;
+};
+
+static SpriteCacheShard _shards[SPRITE_CACHE_SHARD_COUNT];
+static std::atomic<bool> _enabled(true);
+static std::atomic<uint32> _hits(0);
+static std::atomic<uint32> _misses(0);
+static std::atomic<uint32> _evictions(0);
+
+/**
+ * At zoom level z only every (1 << z)th row is drawn, starting from a row that depends on where the sprite
+ * lands on the screen. Each of those row phases is cached separately.
+ */
+static uint32 GetKey(uint32 imageElement, sint32 zoomLevel, sint32 rowPhase)
+{
+    return (imageElement & 0x7FFFF) | ((uint32)zoomLevel << 19) | ((uint32)rowPhase << 21);
+}
+
+static SpriteCacheShard &GetShard(uint32 imageElement)
+{
+    return _shards[imageElement % SPRITE_CACHE_SHARD_COUNT];
+}
+
+static void EvictEntry(SpriteCacheShard &shard, std::list<SpriteCacheEntryPtr>::iterator it)
+{
+    shard.Bytes -= (*it)->GetSize();
+    shard.Lookup.erase((*it)->Key);
+    shard.Entries.erase(it);
+}
+
+/**
+ * Re-encodes the sampled rows and columns of an RLE sprite as a sprite to be drawn at zoom level 0.
+ * Columns are sampled from multiples of the zoom amount, which is where the zoomed blitter starts when
+ * the dpi is aligned to the zoom level.
+ */
+static bool DecimateSprite(const rct_g1_element * g1, sint32 zoomLevel, sint32 rowPhase, SpriteCacheEntry * entry)
+{
+    sint32 zoomAmount = 1 << zoomLevel;
+    sint32 rows = (g1->height - rowPhase + zoomAmount - 1) >> zoomLevel;
+    if (rows <= 0)
+    {
+        return false;
+    }
+
+    std::vector<uint8> &data = entry->Data;
+    data.clear();
+    data.resize(rows * 2);
+    for (sint32 row = 0; row < rows; row++)
+    {
+        if (data.size() > UINT16_MAX)
+        {
+            return false;
+        }
+        uint16 lineOffset = (uint16)data.size();
+        memcpy(&data[row * 2], &lineOffset, sizeof(lineOffset));
+
+        sint32 y = rowPhase + (row << zoomLevel);
+        const uint8 * lineData = g1->offset + ((const uint16 *)g1->offset)[y];
+        size_t runHeader = SIZE_MAX;
+        sint32 runEnd = -1;
+        bool isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            uint8 dataSize = *lineData++;
+            uint8 firstPixelX = *lineData++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+
+            const uint8 * pixels = lineData;
+            lineData += dataSize;
+
+            sint32 x = (firstPixelX + zoomAmount - 1) & ~(zoomAmount - 1);
+            for (; x < firstPixelX + dataSize; x += zoomAmount)
+            {
+                sint32 zoomedX = x >> zoomLevel;
+                if (runHeader == SIZE_MAX || zoomedX != runEnd || data[runHeader] == 0x7F)
+                {
+                    runHeader = data.size();
+                    data.push_back(0);
+                    data.push_back((uint8)zoomedX);
+                }
+                data.push_back(pixels[x - firstPixelX]);
+                data[runHeader]++;
+                runEnd = zoomedX + 1;
+            }
+        }
+
+        if (runHeader == SIZE_MAX)
+        {
+            // Nothing sampled on this row, it still needs a terminating chunk
+            runHeader = data.size();
+            data.push_back(0);
+            data.push_back(0);
+        }
+        data[runHeader] |= 0x80;
+    }
+    data.shrink_to_fit();
+
+    entry->Source = g1->offset;
+    entry->Height = rows;
+    return true;
+}
+
+static SpriteCacheEntryPtr GetEntry(uint32 imageElement, const rct_g1_element * g1, sint32 zoomLevel, sint32 rowPhase)
+{
+    uint32 key = GetKey(imageElement, zoomLevel, rowPhase);
+    SpriteCacheShard &shard = GetShard(imageElement);
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        auto found = shard.Lookup.find(key);
+        if (found != shard.Lookup.end())
+        {
+            if ((*found->second)->Source == g1->offset)
+            {
+                shard.Entries.splice(shard.Entries.begin(), shard.Entries, found->second);
+                _hits++;
+                return *found->second;
+            }
+            EvictEntry(shard, found->second);
+        }
+    }
+
+    // Decimate outside the lock, another thread drawing the same sprite just builds its own copy
+    auto entry = std::make_shared<SpriteCacheEntry>();
+    entry->Key = key;
+    if (!DecimateSprite(g1, zoomLevel, rowPhase, entry.get()))
+    {
+        return nullptr;
+    }
+    _misses++;
+
+    size_t shardBudget = SPRITE_CACHE_DEFAULT_BUDGET / SPRITE_CACHE_SHARD_COUNT;
+    size_t size = entry->GetSize();
+    if (size > shardBudget)
+    {
+        return entry;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    auto found = shard.Lookup.find(key);
+    if (found != shard.Lookup.end())
+    {
+        EvictEntry(shard, found->second);
+    }
+    while (shard.Bytes + size > shardBudget && !shard.Entries.empty())
+    {
+        EvictEntry(shard, std::prev(shard.Entries.end()));
+        _evictions++;
+    }
+    shard.Entries.push_front(entry);
+    shard.Lookup[key] = shard.Entries.begin();
+    shard.Bytes += size;
+    return entry;
+}
+
+extern "C"
+{
+    bool sprite_cache_draw_rle(
+        const rct_drawpixelinfo * dpi,
+        uint32 imageElement,
+        const rct_g1_element * g1,
+        uint8 * destBits,
+        const uint8 * palette,
+        sint32 imageType,
+        sint32 sourceY,
+        sint32 height,
+        sint32 sourceX,
+        sint32 width)
+    {
+        sint32 zoomLevel = dpi->zoom_level;
+        sint32 zoomAmount = 1 << zoomLevel;
+        if (!_enabled || zoomLevel <= 0 || zoomLevel > 3 || (sourceX & (zoomAmount - 1)) != 0)
+        {
+            return false;
+        }
+
+        // Same adjustment as the zoomed blitter makes before drawing the first row
+        sint32 lineWidth = (dpi->width >> zoomLevel) + dpi->pitch;
+        if (sourceY < 0)
+        {
+            sourceY += zoomAmount;
+            height -= zoomAmount;
+            destBits += lineWidth;
+        }
+        if (height <= 0)
+        {
+            return true;
+        }
+
+        sint32 rowPhase = sourceY & (zoomAmount - 1);
+        SpriteCacheEntryPtr entry = GetEntry(imageElement, g1, zoomLevel, rowPhase);
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        rct_drawpixelinfo zoomedDpi = *dpi;
+        zoomedDpi.width = dpi->width >> zoomLevel;
+        zoomedDpi.zoom_level = 0;
+        gfx_rle_sprite_to_buffer(
+            entry->Data.data(),
+            destBits,
+            palette,
+            &zoomedDpi,
+            imageType,
+            sourceY >> zoomLevel,
+            (height + zoomAmount - 1) >> zoomLevel,
+            sourceX >> zoomLevel,
+            (width + zoomAmount - 1) >> zoomLevel);
+        return true;
+    }
+
+    void sprite_cache_invalidate_image(uint32 imageElement)
+    {
+        SpriteCacheShard &shard = GetShard(imageElement);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        if (shard.Entries.empty())
+        {
+            return;
+        }
+        for (sint32 zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+        {
+            for (sint32 rowPhase = 0; rowPhase < (1 << zoomLevel); rowPhase++)
+            {
+                auto found = shard.Lookup.find(GetKey(imageElement, zoomLevel, rowPhase));
+                if (found != shard.Lookup.end())
+                {
+                    EvictEntry(shard, found->second);
+                }
+            }
+        }
+    }
+
+    void sprite_cache_clear()
+    {
+        for (auto &shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            shard.Lookup.clear();
+            shard.Entries.clear();
+            shard.Bytes = 0;
+        }
+    }
+
+    void sprite_cache_set_enabled(bool enabled)
+    {
+        _enabled = enabled;
+        if (!enabled)
+        {
+            sprite_cache_clear();
+        }
+    }
+
+    bool sprite_cache_is_enabled()
+    {
+        return _enabled;
+    }
+
+    void sprite_cache_get_stats(sprite_cache_stats * stats)
+    {
+        *stats = { 0 };
+        for (auto &shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            stats->entries += (uint32)shard.Entries.size();
+            stats->bytes += shard.Bytes;
+        }
+        stats->budget = SPRITE_CACHE_DEFAULT_BUDGET;
+        stats->hits = _hits;
+        stats->misses = _misses;
+        stats->evictions = _evictions;
+    }
+
+    void sprite_cache_reset_stats()
+    {
+        _hits = 0;
+        _misses = 0;
+        _evictions = 0;
+    }
+}
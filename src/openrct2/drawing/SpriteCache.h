@@ -0,0 +1,64 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _DRAWING_SPRITE_CACHE_H_
+#define _DRAWING_SPRITE_CACHE_H_
+
+#include "drawing.h"
+
+// Default memory budget for decimated sprites, shared between all zoom levels
+#define SPRITE_CACHE_DEFAULT_BUDGET (24 * 1024 * 1024)
+
+typedef struct sprite_cache_stats {
+    uint32 entries;     // Decimated sprites currently held
+    size_t bytes;       // Memory used by those sprites
+    size_t budget;      // Memory allowed before the least recently drawn sprites are evicted
+    uint32 hits;        // Draws served from the cache since the stats were reset
+    uint32 misses;      // Draws that had to decimate a sprite first
+    uint32 evictions;   // Sprites dropped to stay within the budget
+} sprite_cache_stats;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * Draws a clipped RLE sprite on a zoomed out dpi from a cached copy of the sprite at that zoom level.
+     * Takes the same arguments as gfx_rle_sprite_to_buffer, returns false if the cache cannot be used.
+     */
+    bool sprite_cache_draw_rle(
+        const rct_drawpixelinfo * dpi,
+        uint32 imageElement,
+        const rct_g1_element * g1,
+        uint8 * destBits,
+        const uint8 * palette,
+        sint32 imageType,
+        sint32 sourceY,
+        sint32 height,
+        sint32 sourceX,
+        sint32 width);
+
+    void sprite_cache_invalidate_image(uint32 imageElement);
+    void sprite_cache_clear();
+    void sprite_cache_set_enabled(bool enabled);
+    bool sprite_cache_is_enabled();
+    void sprite_cache_get_stats(sprite_cache_stats * stats);
+    void sprite_cache_reset_stats();
+#ifdef __cplusplus
+}
+#endif
+
+#endif
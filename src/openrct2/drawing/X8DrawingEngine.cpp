@@ -14,6 +14,7 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <memory>
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../ui/UiContext.h"
@@ -137,6 +138,7 @@ void X8RainDrawer::Restore()
 X8DrawingEngine::X8DrawingEngine(Ui::IUiContext * uiContext)
 {
     _drawingContext = new X8DrawingContext(this);
+    _ownerThreadId = std::this_thread::get_id();
 #ifdef __ENABLE_LIGHTFX__
     lightfx_set_available(true);
     _lastLightFXenabled = (gConfigGeneral.enable_light_fx != 0);
@@ -222,6 +224,7 @@ void X8DrawingEngine::EndDraw()
 void X8DrawingEngine::PaintWindows()
 {
     ResetWindowVisbilities();
+    _frameStats = { };
 
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
@@ -284,8 +287,20 @@ sint32 X8DrawingEngine::Screenshot()
 
 IDrawingContext * X8DrawingEngine::GetDrawingContext(rct_drawpixelinfo * dpi)
 {
-    _drawingContext->SetDPI(dpi);
-    return _drawingContext;
+    // Viewport columns may be drawn from worker threads, each of which needs a context of its own
+    static thread_local std::unique_ptr<X8DrawingContext> workerDrawingContext;
+
+    X8DrawingContext * drawingContext = _drawingContext;
+    if (std::this_thread::get_id() != _ownerThreadId)
+    {
+        if (workerDrawingContext == nullptr || workerDrawingContext->GetEngine() != this)
+        {
+            workerDrawingContext = std::make_unique<X8DrawingContext>(this);
+        }
+        drawingContext = workerDrawingContext.get();
+    }
+    drawingContext->SetDPI(dpi);
+    return drawingContext;
 }
 
 rct_drawpixelinfo * X8DrawingEngine::GetDrawingPixelInfo()
@@ -295,7 +310,7 @@ rct_drawpixelinfo * X8DrawingEngine::GetDrawingPixelInfo()
 
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
-    return DEF_DIRTY_OPTIMISATIONS;
+    return (DRAWING_ENGINE_FLAGS)(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
 }
 
 void X8DrawingEngine::InvalidateImage(uint32 image)
@@ -303,6 +318,11 @@ void X8DrawingEngine::InvalidateImage(uint32 image)
     // Not applicable for this engine
 }
 
+DrawingEngineFrameStats X8DrawingEngine::GetFrameStats()
+{
+    return _frameStats;
+}
+
 rct_drawpixelinfo * X8DrawingEngine::GetDPI()
 {
     return &_bitsDPI;
@@ -395,11 +415,31 @@ void X8DrawingEngine::ResetWindowVisbilities()
 }
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
+{
+    CollectDirtyRegions();
+    CoalesceDirtyRegions();
+
+    for (const DirtyRegion &region : _dirtyRegions)
+    {
+        uint32 columns = region.Right - region.Left;
+        uint32 rows = region.Bottom - region.Top;
+        _frameStats.PaintedBlocks += columns * rows;
+        _frameStats.PaintedRegions++;
+        DrawDirtyBlocks(region.Left, region.Top, columns, rows);
+    }
+}
+
+/**
+ * Splits the dirty blocks into rectangles, each grown as far right and then down as the dirty blocks allow.
+ * The blocks are unset as they are taken.
+ */
+void X8DrawingEngine::CollectDirtyRegions()
 {
     uint32  dirtyBlockColumns = _dirtyGrid.BlockColumns;
     uint32  dirtyBlockRows = _dirtyGrid.BlockRows;
     uint8 * dirtyBlocks = _dirtyGrid.Blocks;
 
+    _dirtyRegions.clear();
     for (uint32 x = 0; x < dirtyBlockColumns; x++)
     {
         for (uint32 y = 0; y < dirtyBlockRows; y++)
@@ -437,7 +477,110 @@ void X8DrawingEngine::DrawAllDirtyBlocks()
 
         endRowCheck:
             uint32 rows = yy - y;
-            DrawDirtyBlocks(x, y, columns, rows);
+            for (yy = y; yy < y + rows; yy++)
+            {
+                memset(&dirtyBlocks[yy * dirtyBlockColumns + x], 0, columns);
+            }
+            _dirtyRegions.push_back({ x, y, x + columns, y + rows });
+            _frameStats.DirtyBlocks += columns * rows;
+        }
+    }
+}
+
+/**
+ * Every repaint walks all the windows and paints the map around its region again, so a handful of clean blocks
+ * is cheaper to repaint than an extra region. Regions are merged into their bounding box while that lowers the
+ * estimated cost, as long as the box does not partly cover another region.
+ */
+void X8DrawingEngine::CoalesceDirtyRegions()
+{
+    // Estimated cost of setting up a repaint, in blocks
+    constexpr uint32 RegionOverheadBlocks = 2;
+    constexpr uint32 MaxSkippedBlocks = 4 * RegionOverheadBlocks;
+    constexpr sint32 MaxPasses = 8;
+
+    auto getArea = [](const DirtyRegion &region) -> uint32
+    {
+        return (region.Right - region.Left) * (region.Bottom - region.Top);
+    };
+
+    std::vector<DirtyRegion> &regions = _dirtyRegions;
+    bool merged = true;
+    for (sint32 pass = 0; pass < MaxPasses && merged; pass++)
+    {
+        merged = false;
+        for (size_t i = 0; i < regions.size(); i++)
+        {
+            size_t j = i + 1;
+            while (j < regions.size())
+            {
+                const DirtyRegion &a = regions[i];
+                const DirtyRegion &b = regions[j];
+                DirtyRegion box = { Math::Min(a.Left, b.Left),
+                                    Math::Min(a.Top, b.Top),
+                                    Math::Max(a.Right, b.Right),
+                                    Math::Max(a.Bottom, b.Bottom) };
+
+                // Regions never overlap, so without other regions inside the box this is what it would repaint
+                // on top of the two regions
+                uint32 coveredArea = getArea(a) + getArea(b);
+                uint32 boxArea = getArea(box);
+                uint32 savedOverhead = RegionOverheadBlocks;
+                if (boxArea - coveredArea >= MaxSkippedBlocks)
+                {
+                    // Boxes around distant regions are not worth looking inside
+                    j++;
+                    continue;
+                }
+
+                bool partlyCovers = false;
+                for (size_t k = 0; k < regions.size() && !partlyCovers; k++)
+                {
+                    const DirtyRegion &other = regions[k];
+                    if (k == i || k == j ||
+                        other.Left >= box.Right || other.Right <= box.Left ||
+                        other.Top >= box.Bottom || other.Bottom <= box.Top)
+                    {
+                        continue;
+                    }
+                    if (other.Left >= box.Left && other.Right <= box.Right &&
+                        other.Top >= box.Top && other.Bottom <= box.Bottom)
+                    {
+                        coveredArea += getArea(other);
+                        savedOverhead += RegionOverheadBlocks;
+                    }
+                    else
+                    {
+                        partlyCovers = true;
+                    }
+                }
+
+                if (partlyCovers || boxArea - coveredArea >= savedOverhead)
+                {
+                    j++;
+                    continue;
+                }
+
+                // Replace the first region with the box and drop every region inside it
+                regions[i] = box;
+                for (size_t k = regions.size(); k-- > 0;)
+                {
+                    const DirtyRegion &other = regions[k];
+                    if (k != i &&
+                        other.Left >= box.Left && other.Right <= box.Right &&
+                        other.Top >= box.Top && other.Bottom <= box.Bottom)
+                    {
+                        regions[k] = regions.back();
+                        regions.pop_back();
+                        if (i == regions.size())
+                        {
+                            i = k;
+                        }
+                    }
+                }
+                merged = true;
+                j = i + 1;
+            }
         }
     }
 }
@@ -18,6 +18,8 @@
 
 #ifdef __cplusplus
 
+#include <thread>
+#include <vector>
 #include "../common.h"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
@@ -44,6 +46,17 @@ namespace OpenRCT2
             uint8 * Blocks;
         };
 
+        /**
+         * A region of the dirty grid to repaint, in blocks. Right and bottom are exclusive.
+         */
+        struct DirtyRegion
+        {
+            uint32  Left;
+            uint32  Top;
+            uint32  Right;
+            uint32  Bottom;
+        };
+
         class X8RainDrawer final : public IRainDrawer
         {
         private:
@@ -81,7 +94,9 @@ namespace OpenRCT2
             size_t  _bitsSize   = 0;
             uint8 * _bits       = nullptr;
 
-            DirtyGrid   _dirtyGrid  = { 0 };
+            DirtyGrid                   _dirtyGrid      = { 0 };
+            std::vector<DirtyRegion>    _dirtyRegions;
+            DrawingEngineFrameStats     _frameStats     = { };
 
             rct_drawpixelinfo _bitsDPI  = { 0 };
 
@@ -91,6 +106,7 @@ namespace OpenRCT2
 
             X8RainDrawer        _rainDrawer;
             X8DrawingContext *  _drawingContext;
+            std::thread::id     _ownerThreadId;
 
         public:
             explicit X8DrawingEngine(Ui::IUiContext * uiContext);
@@ -111,6 +127,7 @@ namespace OpenRCT2
             rct_drawpixelinfo * GetDrawingPixelInfo() override;
             DRAWING_ENGINE_FLAGS GetFlags() override;
             void InvalidateImage(uint32 image) override;
+            DrawingEngineFrameStats GetFrameStats() override;
 
             rct_drawpixelinfo * GetDPI();
 
@@ -122,6 +139,8 @@ namespace OpenRCT2
             void ConfigureDirtyGrid();
             static void ResetWindowVisbilities();
             void DrawAllDirtyBlocks();
+            void CollectDirtyRegions();
+            void CoalesceDirtyRegions();
             void DrawDirtyBlocks(uint32 x, uint32 y, uint32 columns, uint32 rows);
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
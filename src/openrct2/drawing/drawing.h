@@ -369,7 +369,10 @@ void shorten_path(utf8 *buffer, size_t bufferSize, const utf8 *path, sint32 avai
 typedef struct paint_session paint_session;
 
 // scrolling text
+#define MAX_SCROLLING_TEXT_ENTRIES 32
+
 void scrolling_text_initialise_bitmaps();
+uint32 scrolling_text_get_setup_count();
 sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uint16 scroll, uint16 scrollingMode);
 
 rct_size16 FASTCALL gfx_get_sprite_size(uint32 image_id);
@@ -37,8 +37,6 @@ typedef struct rct_draw_scroll_text {
 assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
-#define MAX_SCROLLING_TEXT_ENTRIES 32
-
 static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8 _characterBitmaps[224 * 8];
 static uint32 _drawSCrollNextIndex = 0;
@@ -1417,6 +1415,15 @@ static const sint16* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
  * @param scrollingMode (bp)
  * @returns ebx
  */
+/**
+ * Returns the number of scrolling text lookups so far. A bitmap is only reused once at least
+ * MAX_SCROLLING_TEXT_ENTRIES lookups have happened since it was set up.
+ */
+uint32 scrolling_text_get_setup_count()
+{
+    return _drawSCrollNextIndex;
+}
+
 sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uint16 scroll, uint16 scrollingMode)
 {
     assert(scrollingMode < MAX_SCROLLING_TEXT_MODES);
@@ -18,6 +18,7 @@
 #include "cheats.h"
 #include "config/Config.h"
 #include "Context.h"
+#include "core/Profiling.h"
 #include "Editor.h"
 #include "FileClassifier.h"
 #include "game.h"
@@ -68,6 +69,8 @@ sint32 gGameSpeed = 1;
 float gDayNightCycle = 0;
 bool gInUpdateCode = false;
 bool gInMapInitCode = false;
+bool gGameTurbo = false;
+bool gInTurboUpdate = false;
 sint32 gGameCommandNestLevel;
 bool gGameCommandIsNetworked;
 char gCurrentLoadedPath[MAX_PATH];
@@ -75,6 +78,33 @@ char gCurrentLoadedPath[MAX_PATH];
 uint8 gUnk13CA740;
 uint8 gUnk141F568;
 
+const char * const GameLogicStageNames[GAME_LOGIC_STAGE_COUNT] = {
+    "network",
+    "map_elements",
+    "scenario",
+    "climate",
+    "map_tiles",
+    "path_wide_flags",
+    "peeps",
+    "vehicles",
+    "misc_sprites",
+    "rides",
+    "park",
+    "research",
+    "ride_ratings",
+    "ride_measurements",
+    "news",
+    "map_animations",
+    "sounds",
+    "editor",
+    "network_commands",
+};
+
+bool gGameLogicStageTimingEnabled = false;
+uint64 gGameLogicStageTimes[GAME_LOGIC_STAGE_COUNT];
+static uint64 _gameLogicStageStartTime;
+static bool _gameTurboActive = false;
+
 #ifdef NO_RCT2
 uint32 gCurrentTicks;
 #endif
@@ -281,6 +311,26 @@ void update_palette_effects()
     }
 }
 
+bool game_turbo_is_available()
+{
+    return network_get_mode() == NETWORK_MODE_NONE && gScreenFlags == SCREEN_FLAGS_PLAYING;
+}
+
+/**
+ * Runs ticks until GAME_TURBO_FRAME_TIME_MS has passed. Sounds and invalidation are skipped for those ticks and the
+ * whole screen is invalidated once afterwards instead.
+ */
+static void game_update_turbo()
+{
+    uint32 startTime = platform_get_ticks();
+    gInTurboUpdate = true;
+    do {
+        game_logic_update();
+    } while (platform_get_ticks() - startTime < GAME_TURBO_FRAME_TIME_MS && game_is_not_paused());
+    gInTurboUpdate = false;
+    gfx_invalidate_screen();
+}
+
 void game_update()
 {
     gInUpdateCode = true;
@@ -318,6 +368,21 @@ void game_update()
         network_process_game_commands();
     }
 
+    bool turbo = gGameTurbo && game_turbo_is_available();
+    if (turbo != _gameTurboActive) {
+        _gameTurboActive = turbo;
+        if (turbo) {
+            audio_pause_sounds();
+        } else if (game_is_not_paused()) {
+            audio_unpause_sounds();
+        }
+    }
+
+    if (turbo && numUpdates > 0) {
+        game_update_turbo();
+        numUpdates = 0;
+    }
+
     // Update the game one or more times
     for (sint32 i = 0; i < numUpdates; i++) {
         game_logic_update();
@@ -367,6 +432,8 @@ void game_update()
         game_handle_input();
     }
 
+    scenario_save_update_background();
+
     // Always perform autosave check, even when paused
     if (!(gScreenFlags & SCREEN_FLAGS_TITLE_DEMO) &&
         !(gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) &&
@@ -381,8 +448,33 @@ void game_update()
     gInUpdateCode = false;
 }
 
+static void game_logic_stage_begin()
+{
+    if (gGameLogicStageTimingEnabled || profiling_is_enabled()) {
+        _gameLogicStageStartTime = platform_get_ticks_precise();
+    }
+}
+
+/**
+ * Attributes the time since the previous stage ended to the given stage.
+ */
+static void game_logic_stage_end(sint32 stage)
+{
+    if (gGameLogicStageTimingEnabled || profiling_is_enabled()) {
+        uint64 now = platform_get_ticks_precise();
+        if (gGameLogicStageTimingEnabled) {
+            gGameLogicStageTimes[stage] += now - _gameLogicStageStartTime;
+        }
+        profiling_record(GameLogicStageNames[stage], _gameLogicStageStartTime, now);
+        _gameLogicStageStartTime = now;
+    }
+}
+
 void game_logic_update()
 {
+    uint64 profileStartTime = profiling_begin();
+    game_logic_stage_begin();
+
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
@@ -393,6 +485,8 @@ void game_logic_update()
         // Can't be in sync with server, round trips won't work if we are at same level.
         if (gCurrentTicks >= network_get_server_tick()) {
             // Don't run past the server
+            game_logic_stage_end(GAME_LOGIC_STAGE_NETWORK);
+            profiling_end("game_logic_update", profileStartTime);
             return;
         }
     }
@@ -407,29 +501,48 @@ void game_logic_update()
         // Check desync.
         network_check_desynchronization();
     }
-    
-    sub_68B089();
+    game_logic_stage_end(GAME_LOGIC_STAGE_NETWORK);
+
+    map_compact_elements(MAP_COMPACTION_TILES_PER_TICK);
+    game_logic_stage_end(GAME_LOGIC_STAGE_MAP_ELEMENTS);
     scenario_update();
+    game_logic_stage_end(GAME_LOGIC_STAGE_SCENARIO);
     climate_update();
+    game_logic_stage_end(GAME_LOGIC_STAGE_CLIMATE);
     map_update_tiles();
+    game_logic_stage_end(GAME_LOGIC_STAGE_MAP_TILES);
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
     map_update_path_wide_flags();
+    game_logic_stage_end(GAME_LOGIC_STAGE_PATH_WIDE_FLAGS);
     peep_update_all();
     map_restore_provisional_elements();
+    game_logic_stage_end(GAME_LOGIC_STAGE_PEEPS);
     vehicle_update_all();
+    game_logic_stage_end(GAME_LOGIC_STAGE_VEHICLES);
     sprite_misc_update_all();
+    game_logic_stage_end(GAME_LOGIC_STAGE_MISC_SPRITES);
     ride_update_all();
+    game_logic_stage_end(GAME_LOGIC_STAGE_RIDES);
     park_update();
+    game_logic_stage_end(GAME_LOGIC_STAGE_PARK);
     research_update();
+    game_logic_stage_end(GAME_LOGIC_STAGE_RESEARCH);
     ride_ratings_update_all();
+    game_logic_stage_end(GAME_LOGIC_STAGE_RIDE_RATINGS);
     ride_measurements_update();
+    game_logic_stage_end(GAME_LOGIC_STAGE_RIDE_MEASUREMENTS);
     news_item_update_current();
+    game_logic_stage_end(GAME_LOGIC_STAGE_NEWS);
 
     map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+    game_logic_stage_end(GAME_LOGIC_STAGE_MAP_ANIMATIONS);
+    if (!gInTurboUpdate) {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    }
+    game_logic_stage_end(GAME_LOGIC_STAGE_SOUNDS);
     editor_open_windows_for_current_step();
 
     // Update windows
@@ -451,16 +564,20 @@ void game_logic_update()
     if (gLastAutoSaveUpdate == AUTOSAVE_PAUSE) {
         gLastAutoSaveUpdate = platform_get_ticks();
     }
+    game_logic_stage_end(GAME_LOGIC_STAGE_EDITOR);
 
     // Separated out processing commands in network_update which could call scenario_rand where gInUpdateCode is false.
     // All commands that are received are first queued and then executed where gInUpdateCode is set to true.
     network_process_game_commands();
 
     network_flush();
+    game_logic_stage_end(GAME_LOGIC_STAGE_NETWORK_COMMANDS);
 
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
+
+    profiling_end("game_logic_update", profileStartTime);
 }
 
 /**
@@ -518,6 +635,9 @@ sint32 game_do_command_p(sint32 command, sint32 *eax, sint32 *ebx, sint32 *ecx,
 
     flags = *ebx;
 
+    // Any command may change what is under the cursor
+    viewport_invalidate_pick_cache();
+
     if (gGameCommandNestLevel == 0) {
         gGameCommandErrorText = STR_NONE;
         gGameCommandIsNetworked = (flags & GAME_COMMAND_FLAG_NETWORKED) != 0;
@@ -875,7 +995,7 @@ void pause_toggle()
     window_invalidate_by_class(WC_TOP_TOOLBAR);
     if (gGamePaused & GAME_PAUSED_NORMAL) {
         audio_pause_sounds();
-    } else {
+    } else if (!_gameTurboActive) {
         audio_unpause_sounds();
     }
 }
@@ -1381,7 +1501,10 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    scenario_save(path, saveFlags);
+    // Only the snapshot is taken here, the file is encoded and written on a background thread
+    if (!scenario_save_in_background(path, saveFlags)) {
+        log_error("Unable to autosave to '%s'.", path);
+    }
 }
 
 /**
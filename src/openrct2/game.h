@@ -114,6 +114,30 @@ enum {
     GAME_PAUSED_SAVING_TRACK    = 1 << 2,
 };
 
+// Stages of game_logic_update, in the order they run
+enum GAME_LOGIC_STAGE {
+    GAME_LOGIC_STAGE_NETWORK,
+    GAME_LOGIC_STAGE_MAP_ELEMENTS,
+    GAME_LOGIC_STAGE_SCENARIO,
+    GAME_LOGIC_STAGE_CLIMATE,
+    GAME_LOGIC_STAGE_MAP_TILES,
+    GAME_LOGIC_STAGE_PATH_WIDE_FLAGS,
+    GAME_LOGIC_STAGE_PEEPS,
+    GAME_LOGIC_STAGE_VEHICLES,
+    GAME_LOGIC_STAGE_MISC_SPRITES,
+    GAME_LOGIC_STAGE_RIDES,
+    GAME_LOGIC_STAGE_PARK,
+    GAME_LOGIC_STAGE_RESEARCH,
+    GAME_LOGIC_STAGE_RIDE_RATINGS,
+    GAME_LOGIC_STAGE_RIDE_MEASUREMENTS,
+    GAME_LOGIC_STAGE_NEWS,
+    GAME_LOGIC_STAGE_MAP_ANIMATIONS,
+    GAME_LOGIC_STAGE_SOUNDS,
+    GAME_LOGIC_STAGE_EDITOR,
+    GAME_LOGIC_STAGE_NETWORK_COMMANDS,
+    GAME_LOGIC_STAGE_COUNT
+};
+
 enum {
     ERROR_TYPE_NONE = 0,
     ERROR_TYPE_GENERIC = 254,
@@ -152,6 +176,10 @@ extern sint32 gGameSpeed;
 extern float gDayNightCycle;
 extern bool gInUpdateCode;
 extern bool gInMapInitCode;
+// Turbo runs as many ticks as possible between frames, it is only used in single player parks
+extern bool gGameTurbo;
+// Set while turbo ticks are running, sounds and invalidation are skipped until the frame is drawn
+extern bool gInTurboUpdate;
 extern sint32 gGameCommandNestLevel;
 extern bool gGameCommandIsNetworked;
 extern char gCurrentLoadedPath[260];
@@ -159,6 +187,11 @@ extern char gCurrentLoadedPath[260];
 extern uint8 gUnk13CA740;
 extern uint8 gUnk141F568;
 
+extern const char * const GameLogicStageNames[GAME_LOGIC_STAGE_COUNT];
+// When set, game_logic_update accumulates the time spent in each stage (in microseconds)
+extern bool gGameLogicStageTimingEnabled;
+extern uint64 gGameLogicStageTimes[GAME_LOGIC_STAGE_COUNT];
+
 void game_increase_game_speed();
 void game_reduce_game_speed();
 
@@ -182,6 +215,7 @@ void game_pause_toggle(sint32 *eax, sint32 *ebx, sint32 *ecx, sint32 *edx, sint3
 void pause_toggle();
 bool game_is_paused();
 bool game_is_not_paused();
+bool game_turbo_is_available();
 void save_game();
 void * create_save_game_as_intent();
 void save_game_as();
@@ -14,11 +14,19 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/Console.hpp"
+#include "../core/Json.hpp"
+#include "../core/Math.hpp"
 #include "../Imaging.h"
 #include "../OpenRCT2.h"
 #include "Screenshot.h"
@@ -27,12 +35,284 @@
 #include "../game.h"
 #include "../intro.h"
 #include "../localisation/localisation.h"
+#include "../paint/paint.h"
 #include "../platform/platform.h"
 #include "../util/util.h"
 #include "viewport.h"
 
 using namespace OpenRCT2;
 
+// Rows rendered at a time for images too big to keep in memory, a multiple of every zoom level's alignment
+constexpr sint32 SCREENSHOT_BAND_HEIGHT = 256;
+constexpr size_t SCREENSHOT_BAND_COUNT = 2;
+
+/**
+ * Renders a viewport into a PNG a band of rows at a time. Bands are painted on this thread, with the columns of each
+ * band drawn by the paint workers, while the previous band is compressed on an encoder thread. Only
+ * SCREENSHOT_BAND_COUNT bands are ever held in memory.
+ */
+static bool screenshot_render_banded(rct_viewport * viewport, const rct_palette * palette, const utf8 * path)
+{
+    sint32 width = viewport->width;
+    sint32 height = viewport->height;
+    sint32 bandCount = (height + SCREENSHOT_BAND_HEIGHT - 1) / SCREENSHOT_BAND_HEIGHT;
+
+    std::vector<uint8> bands[SCREENSHOT_BAND_COUNT];
+    for (auto &band : bands)
+    {
+        band.resize((size_t)width * SCREENSHOT_BAND_HEIGHT);
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    sint32 bandsRendered = 0;
+    sint32 bandsEncoded = 0;
+    bool encoderFinished = false;
+    bool result = false;
+
+    std::thread encoder([&]()
+    {
+        sint32 currentBand = -1;
+        bool written = Imaging::PngWriteRows(width, height, palette, path, [&](sint32 y) -> const uint8 *
+        {
+            sint32 band = y / SCREENSHOT_BAND_HEIGHT;
+            if (band != currentBand)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                bandsEncoded = band;
+                condition.notify_all();
+                condition.wait(lock, [&]() { return bandsRendered > band; });
+                currentBand = band;
+            }
+            const std::vector<uint8> &bits = bands[band % SCREENSHOT_BAND_COUNT];
+            return bits.data() + (size_t)(y - band * SCREENSHOT_BAND_HEIGHT) * width;
+        });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        result = written;
+        bandsEncoded = bandCount;
+        encoderFinished = true;
+        condition.notify_all();
+    });
+
+    for (sint32 band = 0; band < bandCount; band++)
+    {
+        {
+            // Wait for the encoder to finish with the band this one replaces
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return encoderFinished || band - bandsEncoded < (sint32)SCREENSHOT_BAND_COUNT; });
+            if (encoderFinished)
+            {
+                break;
+            }
+        }
+
+        std::vector<uint8> &bits = bands[band % SCREENSHOT_BAND_COUNT];
+        std::fill(bits.begin(), bits.end(), 0);
+
+        sint32 top = band * SCREENSHOT_BAND_HEIGHT;
+        sint32 bottom = Math::Min(height, top + SCREENSHOT_BAND_HEIGHT);
+
+        rct_drawpixelinfo dpi;
+        dpi.bits = bits.data();
+        dpi.x = 0;
+        dpi.y = top;
+        dpi.width = width;
+        dpi.height = bottom - top;
+        dpi.pitch = 0;
+        dpi.zoom_level = 0;
+        viewport_render(&dpi, viewport, 0, top, width, bottom);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        bandsRendered = band + 1;
+        condition.notify_all();
+    }
+
+    encoder.join();
+    return result;
+}
+
+/**
+ * Centres the viewport on the given map coordinates and sets the zoom and the current rotation.
+ */
+static void screenshot_centre_viewport(rct_viewport * viewport, sint32 mapX, sint32 mapY, sint32 zoom, sint32 rotation)
+{
+    sint32 x = 0, y = 0;
+    sint32 z = map_element_height(mapX, mapY) & 0xFFFF;
+    switch (rotation) {
+    case 0:
+        x = mapY - mapX;
+        y = ((mapX + mapY) / 2) - z;
+        break;
+    case 1:
+        x = -mapY - mapX;
+        y = ((-mapX + mapY) / 2) - z;
+        break;
+    case 2:
+        x = -mapY + mapX;
+        y = ((-mapX - mapY) / 2) - z;
+        break;
+    case 3:
+        x = mapY + mapX;
+        y = ((mapX - mapY) / 2) - z;
+        break;
+    }
+
+    viewport->view_x = x - ((viewport->view_width << zoom) / 2);
+    viewport->view_y = y - ((viewport->view_height << zoom) / 2);
+    viewport->zoom = zoom;
+    gCurrentRotation = rotation;
+}
+
+struct BenchGfxViewFlags
+{
+    const char * Name;
+    uint32       Flags;
+};
+
+static constexpr const BenchGfxViewFlags BenchGfxViewFlagSets[] =
+{
+    { "normal",      0                                                                                               },
+    { "underground", VIEWPORT_FLAG_UNDERGROUND_INSIDE                                                                },
+    { "seethrough",  VIEWPORT_FLAG_SEETHROUGH_RIDES | VIEWPORT_FLAG_SEETHROUGH_SCENERY | VIEWPORT_FLAG_SEETHROUGH_PATHS },
+    { "gridlines",   VIEWPORT_FLAG_GRIDLINES                                                                         },
+};
+
+static constexpr const sint32 BenchGfxViewportSizes[][2] =
+{
+    { 1280, 720  },
+    { 1920, 1080 },
+    { 3840, 2160 },
+};
+
+struct BenchGfxCaseResult
+{
+    sint32 Zoom;
+    sint32 Rotation;
+    sint32 Width;
+    sint32 Height;
+    const char * ViewFlagsName;
+    std::vector<double> FrameTimes;                 // Milliseconds, sorted
+    double PhaseTimes[PAINT_PHASE_COUNT];           // Milliseconds per frame, summed over all paint threads
+};
+
+/**
+ * Nearest rank percentile of sorted samples.
+ */
+static double benchgfx_percentile(const std::vector<double> &sortedSamples, double percentile)
+{
+    size_t rank = (size_t)std::ceil(percentile / 100.0 * sortedSamples.size());
+    rank = Math::Clamp<size_t>(1, rank, sortedSamples.size());
+    return sortedSamples[rank - 1];
+}
+
+static double benchgfx_mean(const std::vector<double> &samples)
+{
+    double total = 0;
+    for (double sample : samples)
+    {
+        total += sample;
+    }
+    return total / samples.size();
+}
+
+static BenchGfxCaseResult benchgfx_run_case(sint32 iterationCount, sint32 zoom, sint32 rotation, sint32 width, sint32 height, const BenchGfxViewFlags &viewFlags)
+{
+    BenchGfxCaseResult result;
+    result.Zoom = zoom;
+    result.Rotation = rotation;
+    result.Width = width;
+    result.Height = height;
+    result.ViewFlagsName = viewFlags.Name;
+
+    rct_viewport viewport;
+    viewport.x = 0;
+    viewport.y = 0;
+    viewport.width = width;
+    viewport.height = height;
+    viewport.view_width = width;
+    viewport.view_height = height;
+    viewport.var_11 = 0;
+    viewport.flags = viewFlags.Flags;
+
+    sint32 centre = (gMapSize / 2) * 32 + 16;
+    screenshot_centre_viewport(&viewport, centre, centre, zoom, rotation);
+    reset_all_sprite_quadrant_placements();
+
+    std::vector<uint8> bits((size_t)width * height);
+    rct_drawpixelinfo dpi;
+    dpi.bits = bits.data();
+    dpi.x = 0;
+    dpi.y = 0;
+    dpi.width = width;
+    dpi.height = height;
+    dpi.pitch = 0;
+    dpi.zoom_level = 0;
+
+    // Warm up caches before anything is measured
+    viewport_render(&dpi, &viewport, 0, 0, width, height);
+
+    uint64 phaseTotals[PAINT_PHASE_COUNT];
+    paint_reset_phase_times();
+    gPaintPhaseTimingEnabled = true;
+    for (sint32 i = 0; i < iterationCount; i++)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        viewport_render(&dpi, &viewport, 0, 0, width, height);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> duration = endTime - startTime;
+        result.FrameTimes.push_back(duration.count());
+    }
+    gPaintPhaseTimingEnabled = false;
+    paint_get_phase_times(phaseTotals);
+
+    std::sort(result.FrameTimes.begin(), result.FrameTimes.end());
+    for (sint32 phase = 0; phase < PAINT_PHASE_COUNT; phase++)
+    {
+        result.PhaseTimes[phase] = phaseTotals[phase] / 1000.0 / iterationCount;
+    }
+    return result;
+}
+
+static json_t * benchgfx_results_to_json(const utf8 * parkPath, const utf8 * engineName, sint32 iterationCount, const std::vector<BenchGfxCaseResult> &results)
+{
+    json_t * jsonCases = json_array();
+    for (const auto &result : results)
+    {
+        json_t * jsonFrame = json_object();
+        json_object_set_new(jsonFrame, "mean", json_real(benchgfx_mean(result.FrameTimes)));
+        json_object_set_new(jsonFrame, "min", json_real(result.FrameTimes.front()));
+        json_object_set_new(jsonFrame, "p50", json_real(benchgfx_percentile(result.FrameTimes, 50)));
+        json_object_set_new(jsonFrame, "p90", json_real(benchgfx_percentile(result.FrameTimes, 90)));
+        json_object_set_new(jsonFrame, "p99", json_real(benchgfx_percentile(result.FrameTimes, 99)));
+        json_object_set_new(jsonFrame, "max", json_real(result.FrameTimes.back()));
+
+        json_t * jsonPhases = json_object();
+        for (sint32 phase = 0; phase < PAINT_PHASE_COUNT; phase++)
+        {
+            json_object_set_new(jsonPhases, PaintPhaseNames[phase], json_real(result.PhaseTimes[phase]));
+        }
+
+        json_t * jsonCase = json_object();
+        json_object_set_new(jsonCase, "zoom", json_integer(result.Zoom));
+        json_object_set_new(jsonCase, "rotation", json_integer(result.Rotation));
+        json_object_set_new(jsonCase, "width", json_integer(result.Width));
+        json_object_set_new(jsonCase, "height", json_integer(result.Height));
+        json_object_set_new(jsonCase, "view", json_string(result.ViewFlagsName));
+        json_object_set_new(jsonCase, "frame_ms", jsonFrame);
+        json_object_set_new(jsonCase, "phase_ms", jsonPhases);
+        json_array_append_new(jsonCases, jsonCase);
+    }
+
+    json_t * jsonResults = json_object();
+    json_object_set_new(jsonResults, "park", json_string(parkPath));
+    json_object_set_new(jsonResults, "engine", json_string(engineName));
+    json_object_set_new(jsonResults, "multithreading", json_boolean(paint_session_can_draw_async()));
+    json_object_set_new(jsonResults, "iterations", json_integer(iterationCount));
+    json_object_set_new(jsonResults, "cases", jsonCases);
+    return jsonResults;
+}
+
 extern "C"
 {
 uint8 gScreenshotCountdown = 0;
@@ -209,17 +489,6 @@ void screenshot_giant()
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
 
-    rct_drawpixelinfo dpi;
-    dpi.x = 0;
-    dpi.y = 0;
-    dpi.width = resolutionWidth;
-    dpi.height = resolutionHeight;
-    dpi.pitch = 0;
-    dpi.zoom_level = 0;
-    dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
-    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
     // Get a free screenshot path
     char path[MAX_PATH];
     sint32 index;
@@ -232,9 +501,11 @@ void screenshot_giant()
     rct_palette renderedPalette;
     screenshot_get_rendered_palette(&renderedPalette);
 
-    image_io_png_write(&dpi, &renderedPalette, path);
-
-    free(dpi.bits);
+    if (!screenshot_render_banded(&viewport, &renderedPalette, path)) {
+        log_error("Giant screenshot failed, unable to write '%s'.", path);
+        context_show_error(STR_SCREENSHOT_FAILED, STR_NONE);
+        return;
+    }
 
     // Show user that screenshot saved successfully
     set_format_arg(0, rct_string_id, STR_STRING);
@@ -333,6 +604,97 @@ sint32 cmdline_for_gfxbench(const char **argv, sint32 argc)
     return 1;
 }
 
+/**
+ * Renders every combination of zoom level, rotation, viewport size and view flags around the centre of the map,
+ * reporting frame time percentiles and the time spent generating, arranging and drawing paint structs.
+ */
+sint32 cmdline_for_gfxbench_suite(const char **argv, sint32 argc)
+{
+    if (argc < 1 || argc > 3) {
+        printf("Usage: openrct2 benchgfx suite <file> [<iteration_count>] [<json_output>]\n");
+        return -1;
+    }
+
+    const char * inputPath = argv[0];
+    const char * jsonPath = argc == 3 ? argv[2] : nullptr;
+    sint32 iterationCount = 10;
+    if (argc >= 2)
+    {
+        iterationCount = atoi(argv[1]);
+        if (iterationCount <= 0)
+        {
+            Console::Error::WriteLine("Iteration count must be a positive number.");
+            return -1;
+        }
+    }
+
+    sint32 result = -1;
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (context->Initialise())
+    {
+        drawing_engine_init();
+        if (context->LoadParkFromFile(inputPath))
+        {
+            gIntroState = INTRO_STATE_NONE;
+            gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+            char engineName[128];
+            rct_string_id engineId = DrawingEngineStringIds[drawing_engine_get_type()];
+            format_string(engineName, sizeof(engineName), engineId, nullptr);
+
+            Console::WriteLine("%4s %3s %11s %-11s %9s %9s %9s %9s %9s %9s %9s",
+                               "Zoom", "Rot", "Size", "View", "Mean", "p50", "p90", "p99",
+                               "Generate", "Arrange", "Draw");
+
+            std::vector<BenchGfxCaseResult> results;
+            for (const auto &size : BenchGfxViewportSizes)
+            {
+                for (const auto &viewFlags : BenchGfxViewFlagSets)
+                {
+                    for (sint32 zoom = 0; zoom < 4; zoom++)
+                    {
+                        for (sint32 rotation = 0; rotation < 4; rotation++)
+                        {
+                            auto caseResult = benchgfx_run_case(iterationCount, zoom, rotation, size[0], size[1], viewFlags);
+                            Console::WriteLine("%4d %3d %5dx%-5d %-11s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f",
+                                               zoom, rotation, size[0], size[1], viewFlags.Name,
+                                               benchgfx_mean(caseResult.FrameTimes),
+                                               benchgfx_percentile(caseResult.FrameTimes, 50),
+                                               benchgfx_percentile(caseResult.FrameTimes, 90),
+                                               benchgfx_percentile(caseResult.FrameTimes, 99),
+                                               caseResult.PhaseTimes[PAINT_PHASE_GENERATE],
+                                               caseResult.PhaseTimes[PAINT_PHASE_ARRANGE],
+                                               caseResult.PhaseTimes[PAINT_PHASE_DRAW]);
+                            results.push_back(std::move(caseResult));
+                        }
+                    }
+                }
+            }
+            Console::WriteLine("Times are in milliseconds per frame using drawing engine %s, phase times are summed over all paint threads.", engineName);
+            result = 1;
+
+            if (jsonPath != nullptr)
+            {
+                json_t * jsonResults = benchgfx_results_to_json(inputPath, engineName, iterationCount, results);
+                try
+                {
+                    Json::WriteToFile(jsonPath, jsonResults);
+                }
+                catch (const std::exception &ex)
+                {
+                    Console::Error::WriteLine("Unable to write results: %s", ex.what());
+                    result = -1;
+                }
+                json_decref(jsonResults);
+            }
+        }
+        drawing_engine_dispose();
+    }
+    delete context;
+    return result;
+}
+
 sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
 {
     bool giantScreenshot = argc == 5 && _stricmp(argv[2], "giant") == 0;
@@ -413,31 +775,7 @@ sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
             if (centreMapY)
                 customY = (mapSize / 2) * 32 + 16;
 
-            sint32 x = 0, y = 0;
-            sint32 z = map_element_height(customX, customY) & 0xFFFF;
-            switch (customRotation) {
-            case 0:
-                x = customY - customX;
-                y = ((customX + customY) / 2) - z;
-                break;
-            case 1:
-                x = -customY - customX;
-                y = ((-customX + customY) / 2) - z;
-                break;
-            case 2:
-                x = -customY + customX;
-                y = ((-customX - customY) / 2) - z;
-                break;
-            case 3:
-                x = customY + customX;
-                y = ((customX - customY) / 2) - z;
-                break;
-            }
-
-            viewport.view_x = x - ((viewport.view_width << customZoom) / 2);
-            viewport.view_y = y - ((viewport.view_height << customZoom) / 2);
-            viewport.zoom = customZoom;
-            gCurrentRotation = customRotation;
+            screenshot_centre_viewport(&viewport, customX, customY, customZoom, customRotation);
         } else {
             viewport.view_x = gSavedViewX - (viewport.view_width / 2);
             viewport.view_y = gSavedViewY - (viewport.view_height / 2);
@@ -448,23 +786,13 @@ sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
         // Ensure sprites appear regardless of rotation
         reset_all_sprite_quadrant_placements();
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.zoom_level = 0;
-        dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
         rct_palette renderedPalette;
         screenshot_get_rendered_palette(&renderedPalette);
 
-        image_io_png_write(&dpi, &renderedPalette, outputPath);
+        if (!screenshot_render_banded(&viewport, &renderedPalette, outputPath)) {
+            Console::Error::WriteLine("Unable to write '%s'.", outputPath);
+        }
 
-        free(dpi.bits);
         drawing_engine_dispose();
     }
     delete context;
@@ -32,6 +32,7 @@ extern "C"
     void screenshot_giant();
     sint32 cmdline_for_screenshot(const char **argv, sint32 argc);
     sint32 cmdline_for_gfxbench(const char **argv, sint32 argc);
+    sint32 cmdline_for_gfxbench_suite(const char **argv, sint32 argc);
 #ifdef __cplusplus
 }
 #endif
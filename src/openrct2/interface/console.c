@@ -18,7 +18,9 @@
 
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/Profiling.h"
 #include "../drawing/drawing.h"
+#include "../drawing/SpriteCache.h"
 #include "../Editor.h"
 #include "../game.h"
 #include "../input.h"
@@ -32,6 +34,7 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
+#include "../paint/paint.h"
 #include "../peep/Staff.h"
 #include "../platform/platform.h"
 #include "../ride/ride.h"
@@ -41,6 +44,7 @@
 #include "../Version.h"
 #include "../world/Climate.h"
 #include "../world/park.h"
+#include "../world/ParkStatistics.h"
 #include "../world/scenery.h"
 #include "console.h"
 #include "viewport.h"
@@ -791,6 +795,12 @@ static sint32 cc_get(const utf8 **argv, sint32 argc)
         else if (strcmp(argv[0], "game_speed") == 0) {
             console_printf("game_speed %d", gGameSpeed);
         }
+        else if (strcmp(argv[0], "game_turbo") == 0) {
+            console_printf("game_turbo %d", gGameTurbo);
+            if (gGameTurbo && !game_turbo_is_available()) {
+                console_writeline_warning("Turbo is only used in single player parks.");
+            }
+        }
         else if (strcmp(argv[0], "console_small_font") == 0) {
             console_printf("console_small_font %d", gConfigInterface.console_small_font);
         }
@@ -991,6 +1001,10 @@ static sint32 cc_set(const utf8 **argv, sint32 argc)
             gGameSpeed = clamp(int_val[0], 1, 8);
             console_execute_silent("get game_speed");
         }
+        else if (strcmp(argv[0], "game_turbo") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+            gGameTurbo = (int_val[0] != 0);
+            console_execute_silent("get game_turbo");
+        }
         else if (strcmp(argv[0], "console_small_font") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
             gConfigInterface.console_small_font = (int_val[0] != 0);
             config_save_default();
@@ -1293,12 +1307,130 @@ static sint32 cc_show_limits(const utf8 ** argv, sint32 argc)
 
     console_printf("Sprites: %d/%d", spriteCount, MAX_SPRITES);
     console_printf("Map Elements: %d/%d", mapElementCount, MAX_MAP_ELEMENTS);
+    console_printf("Map Element Store: %u", gMapElementsCapacity);
     console_printf("Banners: %d/%d", bannerCount, MAX_BANNERS);
     console_printf("Rides: %d/%d", rideCount, MAX_RIDES);
     console_printf("Staff: %d/%d", staffCount, STAFF_MAX_COUNT);
     return 0;
 }
 
+static sint32 cc_map_fragmentation(const utf8 ** argv, sint32 argc)
+{
+    map_element_store_stats stats;
+    map_get_element_store_stats(&stats);
+
+    console_printf("Store capacity: %u elements", stats.capacity);
+    console_printf("In use: %u live, %u removed, %u free", stats.live, stats.removed, stats.capacity - stats.used);
+    console_printf("Fragmentation: %u gaps, largest %u, %d%% of used space removed",
+        stats.gaps,
+        stats.largest_gap,
+        stats.used == 0 ? 0 : (sint32)(((uint64)stats.removed * 100) / stats.used));
+    console_printf("Compactor: %s, %u sweeps, %u tiles moved",
+        stats.compacting ? "sweeping" : "idle",
+        stats.sweeps,
+        stats.tiles_moved);
+    return 0;
+}
+
+static sint32 cc_paint_stats(const utf8 ** argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "reset") == 0) {
+        paint_reset_arena_stats();
+        console_writeline("Paint statistics reset.");
+        return 0;
+    }
+
+    paint_arena_stats stats;
+    paint_get_arena_stats(&stats);
+    console_printf("Sessions painted: %u", stats.sessions);
+    console_printf("Most paint entries in a session: %u", stats.high_water_entries);
+    console_printf("Chunks: %u of %d entries, %u KiB",
+        stats.chunks,
+        PAINT_ENTRY_CHUNK_SIZE,
+        (uint32)((stats.chunks * sizeof(paint_entry_chunk)) / 1024));
+    console_printf("Entries dropped: %u", stats.dropped_entries);
+    return 0;
+}
+
+static sint32 cc_sprite_cache(const utf8 ** argv, sint32 argc)
+{
+    if (argc > 0) {
+        if (strcmp(argv[0], "clear") == 0) {
+            sprite_cache_clear();
+            sprite_cache_reset_stats();
+        } else if (strcmp(argv[0], "on") == 0) {
+            sprite_cache_set_enabled(true);
+        } else if (strcmp(argv[0], "off") == 0) {
+            sprite_cache_set_enabled(false);
+        } else {
+            console_writeline_error("Unknown subcommand, use clear, on or off.");
+            return 1;
+        }
+    }
+
+    sprite_cache_stats stats;
+    sprite_cache_get_stats(&stats);
+    console_printf("Sprite cache: %s", sprite_cache_is_enabled() ? "on" : "off");
+    console_printf("Sprites: %u, %u of %u KiB",
+        stats.entries,
+        (uint32)(stats.bytes / 1024),
+        (uint32)(stats.budget / 1024));
+    console_printf("Hits: %u, misses: %u, evictions: %u", stats.hits, stats.misses, stats.evictions);
+    return 0;
+}
+
+static sint32 cc_guest_stats(const utf8 ** argv, sint32 argc)
+{
+    if (argc > 1 && strcmp(argv[0], "verify") == 0) {
+        park_statistics_set_verify(strcmp(argv[1], "on") == 0);
+    }
+
+    const park_guest_statistics * stats = park_statistics_get();
+    console_printf("Guests: %u (%u in park)", stats->guests, stats->guests_in_park);
+    console_printf("Happy guests: %u", stats->happy_guests);
+    console_printf("Lost guests: %u", stats->lost_guests);
+    console_printf("Staff: %u", stats->staff);
+    console_printf("Verify: %s, mismatches: %u", park_statistics_get_verify() ? "on" : "off", park_statistics_get_mismatch_count());
+    return 0;
+}
+
+static sint32 cc_profile(const utf8 ** argv, sint32 argc)
+{
+    if (argc > 0) {
+        if (strcmp(argv[0], "start") == 0) {
+            profiling_start();
+            console_writeline("Profiling started.");
+            return 0;
+        } else if (strcmp(argv[0], "stop") == 0) {
+            profiling_stop();
+            console_printf("Profiling stopped, %d events recorded.", (sint32)profiling_get_event_count());
+            return 0;
+        } else if (strcmp(argv[0], "clear") == 0) {
+            profiling_clear();
+            console_writeline("Profiling events cleared.");
+            return 0;
+        } else if (strcmp(argv[0], "status") == 0) {
+            console_printf("Profiling is %s, %d/%d events recorded.",
+                profiling_is_enabled() ? "enabled" : "disabled",
+                (sint32)profiling_get_event_count(),
+                PROFILING_MAX_EVENTS);
+            return 0;
+        } else if (strcmp(argv[0], "export") == 0) {
+            if (argc < 2) {
+                console_writeline_error("Expected a path to export to.");
+                return 1;
+            }
+            if (!profiling_export_chrome_trace(argv[1])) {
+                console_writeline_error("Unable to export profile.");
+                return 1;
+            }
+            console_printf("Exported %d events to %s", (sint32)profiling_get_event_count(), argv[1]);
+            return 0;
+        }
+    }
+    console_printf("subcommands: start, stop, clear, status, export <path>");
+    return 0;
+}
 
 typedef sint32 (*console_command_func)(const utf8 **argv, sint32 argc);
 typedef struct console_command {
@@ -1333,6 +1465,7 @@ static const utf8* console_variable_table[] = {
     "park_open",
     "climate",
     "game_speed",
+    "game_turbo",
     "console_small_font",
     "test_unfinished_tracks",
     "no_test_crashes",
@@ -1376,6 +1509,11 @@ static const console_command console_command_table[] = {
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences"},
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
+    { "map_fragmentation", cc_map_fragmentation, "Shows how fragmented the map element store is.", "map_fragmentation" },
+    { "paint_stats", cc_paint_stats, "Shows how many paint entries viewports use.", "paint_stats [reset]" },
+    { "sprite_cache", cc_sprite_cache, "Shows or controls the cache of sprites decimated for zoomed out views.", "sprite_cache [clear|on|off]" },
+    { "guest_stats", cc_guest_stats, "Shows the guest totals used by the park rating and awards.", "guest_stats [verify on|off]" },
+    { "profile", cc_profile, "Records timings of the game loop and rendering, exportable as a Chrome trace.", "profile <subcommand>" },
 };
 
 static sint32 cc_windows(const utf8 **argv, sint32 argc) {
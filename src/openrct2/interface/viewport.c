@@ -16,6 +16,7 @@
 
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/Profiling.h"
 #include "../drawing/drawing.h"
 #include "../game.h"
 #include "../input.h"
@@ -23,6 +24,7 @@
 #include "../paint/paint.h"
 #include "../paint/supports.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
 #include "../ride/ride_data.h"
 #include "../ride/track_data.h"
 #include "../world/banner.h"
@@ -66,7 +68,31 @@ static sint16 _interactionMapX;
 static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
+// Picks within the same block of the view reuse the paint structs arranged for that block
+#define VIEWPORT_PICK_BLOCK_SIZE 32
+
+typedef struct viewport_pick_cache {
+    paint_session * session;
+    paint_struct ps;
+    rct_drawpixelinfo dpi;
+    uint32 serial;
+    uint32 ticks;
+    uint8 rotation;
+    uint32 view_flags;
+    uint16 map_select_flags;
+    uint16 map_select_type;
+    LocationXY16 map_select_a;
+    LocationXY16 map_select_b;
+    LocationXYZ16 map_select_arrow;
+    uint8 map_select_arrow_direction;
+} viewport_pick_cache;
+
+static viewport_pick_cache _pickCache;
+static uint32 _pickCacheSerial = 1;
+
+static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags, bool drawAsync);
+static void viewport_draw_column(paint_session * session, uint32 viewFlags);
+static void viewport_draw_column_text(paint_session * session, uint32 viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
 /**
@@ -676,6 +702,7 @@ void viewport_render(rct_drawpixelinfo *dpi, rct_viewport *viewport, sint32 left
  */
 void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left, sint16 top, sint16 right, sint16 bottom)
 {
+    uint64 profileStartTime = profiling_begin();
     uint32 viewFlags = viewport->flags;
     uint16 width = right - left;
     uint16 height = bottom - top;
@@ -709,8 +736,18 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
     // this as well as the [x += 32] in the loop causes signed integer overflow -> undefined behaviour.
     sint16 rightBorder = dpi1.x + dpi1.width;
 
+    // Columns are generated on this thread and, when supported, arranged and drawn on worker threads
+    bool drawAsync = paint_session_can_draw_async();
+    uint32 scrollingTextSetupStart = scrolling_text_get_setup_count();
+
     // Splits the area into 32 pixel columns and renders them
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32) {
+        // Scrolling text bitmaps get recycled, so let columns that may still be drawing them finish first
+        if (drawAsync && scrolling_text_get_setup_count() - scrollingTextSetupStart >= MAX_SCROLLING_TEXT_ENTRIES / 2) {
+            paint_session_wait_all();
+            scrollingTextSetupStart = scrolling_text_get_setup_count();
+        }
+
         rct_drawpixelinfo dpi2 = dpi1;
         if (x >= dpi2.x) {
             sint16 leftPitch = x - dpi2.x;
@@ -728,11 +765,17 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags);
+        viewport_paint_column(&dpi2, viewFlags, drawAsync);
+    }
+
+    if (drawAsync) {
+        paint_session_wait_all();
     }
+
+    profiling_end("viewport_paint", profileStartTime);
 }
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags, bool drawAsync)
 {
     gCurrentViewportFlags = viewFlags;
 
@@ -745,10 +788,39 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     }
 
     paint_session * session = paint_session_alloc(dpi);
+    uint64 generateStartTime = gPaintPhaseTimingEnabled ? platform_get_ticks_precise() : 0;
     paint_session_generate(session);
+    if (gPaintPhaseTimingEnabled) {
+        session->PhaseTimes[PAINT_PHASE_GENERATE] = platform_get_ticks_precise() - generateStartTime;
+    }
+    profiling_counter("paint_structs", paint_session_get_entry_count(session));
+
+    if (drawAsync) {
+        paint_session_draw_async(session, viewFlags, viewport_draw_column, viewport_draw_column_text);
+    } else {
+        viewport_draw_column(session, viewFlags);
+        viewport_draw_column_text(session, viewFlags);
+        paint_session_free(session);
+    }
+}
+
+/**
+ * Arranges and draws the sprites of a generated column. May run on a worker thread, so only the
+ * column's own pixels may be written.
+ */
+static void viewport_draw_column(paint_session * session, uint32 viewFlags)
+{
+    rct_drawpixelinfo * dpi = session->Unk140E9A8;
+    uint64 arrangeStartTime = gPaintPhaseTimingEnabled ? platform_get_ticks_precise() : 0;
     paint_struct ps = paint_session_arrange(session);
+    uint64 drawStartTime = gPaintPhaseTimingEnabled ? platform_get_ticks_precise() : 0;
+    uint64 profileStartTime = profiling_begin();
     paint_draw_structs(dpi, &ps, viewFlags);
-    paint_session_free(session);
+    profiling_end("paint_draw_structs", profileStartTime);
+    if (gPaintPhaseTimingEnabled) {
+        session->PhaseTimes[PAINT_PHASE_ARRANGE] = drawStartTime - arrangeStartTime;
+        session->PhaseTimes[PAINT_PHASE_DRAW] = platform_get_ticks_precise() - drawStartTime;
+    }
 
     if (gConfigGeneral.render_weather_gloom &&
         !gTrackDesignSaveMode &&
@@ -756,9 +828,15 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     ) {
         viewport_paint_weather_gloom(dpi);
     }
+}
 
+/**
+ * Draws the floating money text of a column, which uses the shared font state.
+ */
+static void viewport_draw_column_text(paint_session * session, uint32 viewFlags)
+{
     if (session->PSStringHead != NULL) {
-        paint_draw_money_structs(dpi, session->PSStringHead);
+        paint_draw_money_structs(session->Unk140E9A8, session->PSStringHead);
     }
 }
 
@@ -1335,6 +1413,75 @@ static void sub_68862C(rct_drawpixelinfo * dpi, paint_struct * ps)
     }
 }
 
+static bool viewport_pick_cache_is_valid(const viewport_pick_cache * cache, const rct_drawpixelinfo * blockDpi)
+{
+    return cache->session != NULL &&
+        cache->serial == _pickCacheSerial &&
+        cache->ticks == gCurrentTicks &&
+        cache->dpi.x == blockDpi->x &&
+        cache->dpi.y == blockDpi->y &&
+        cache->dpi.zoom_level == blockDpi->zoom_level &&
+        cache->rotation == get_current_rotation() &&
+        cache->view_flags == gCurrentViewportFlags &&
+        cache->map_select_flags == gMapSelectFlags &&
+        cache->map_select_type == gMapSelectType &&
+        cache->map_select_a.x == gMapSelectPositionA.x &&
+        cache->map_select_a.y == gMapSelectPositionA.y &&
+        cache->map_select_b.x == gMapSelectPositionB.x &&
+        cache->map_select_b.y == gMapSelectPositionB.y &&
+        cache->map_select_arrow.x == gMapSelectArrowPosition.x &&
+        cache->map_select_arrow.y == gMapSelectArrowPosition.y &&
+        cache->map_select_arrow.z == gMapSelectArrowPosition.z &&
+        cache->map_select_arrow_direction == gMapSelectArrowDirection;
+}
+
+/**
+ * Returns the arranged paint structs of the view block containing the given 1x1 pixel area,
+ * painting the block again only if something that affects painting has changed since.
+ */
+static viewport_pick_cache * viewport_get_pick_cache(const rct_drawpixelinfo * dpi)
+{
+    rct_drawpixelinfo blockDpi = { 0 };
+    blockDpi.x = floor2(dpi->x, VIEWPORT_PICK_BLOCK_SIZE);
+    blockDpi.y = floor2(dpi->y, VIEWPORT_PICK_BLOCK_SIZE);
+    blockDpi.width = VIEWPORT_PICK_BLOCK_SIZE;
+    blockDpi.height = VIEWPORT_PICK_BLOCK_SIZE;
+    blockDpi.zoom_level = dpi->zoom_level;
+
+    viewport_pick_cache * cache = &_pickCache;
+    if (viewport_pick_cache_is_valid(cache, &blockDpi)) {
+        return cache;
+    }
+
+    if (cache->session != NULL) {
+        paint_session_free(cache->session);
+    }
+    cache->dpi = blockDpi;
+    cache->session = paint_session_alloc(&cache->dpi);
+    paint_session_generate(cache->session);
+    cache->ps = paint_session_arrange(cache->session);
+
+    cache->serial = _pickCacheSerial;
+    cache->ticks = gCurrentTicks;
+    cache->rotation = get_current_rotation();
+    cache->view_flags = gCurrentViewportFlags;
+    cache->map_select_flags = gMapSelectFlags;
+    cache->map_select_type = gMapSelectType;
+    cache->map_select_a = gMapSelectPositionA;
+    cache->map_select_b = gMapSelectPositionB;
+    cache->map_select_arrow = gMapSelectArrowPosition;
+    cache->map_select_arrow_direction = gMapSelectArrowDirection;
+    return cache;
+}
+
+/**
+ * Called whenever the map or anything on it may change outside of a game tick.
+ */
+void viewport_invalidate_pick_cache()
+{
+    _pickCacheSerial++;
+}
+
 /**
  *
  *  rct2: 0x00685ADC
@@ -1375,11 +1522,8 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
             dpi->x = _viewportDpi1.x;
             dpi->width = 1;
 
-            paint_session * session = paint_session_alloc(dpi);
-            paint_session_generate(session);
-            paint_struct ps = paint_session_arrange(session);
-            sub_68862C(dpi, &ps);
-            paint_session_free(session);
+            viewport_pick_cache * cache = viewport_get_pick_cache(dpi);
+            sub_68862C(dpi, &cache->ps);
         }
         if (viewport != NULL) *viewport = myviewport;
     }
@@ -21,6 +21,7 @@
 #include "../peep/Peep.h"
 #include "../ride/ride.h"
 #include "../scenario/scenario.h"
+#include "../world/ParkStatistics.h"
 #include "../world/sprite.h"
 #include "Award.h"
 #include "NewsItem.h"
@@ -79,13 +80,22 @@ bool award_is_positive(sint32 type)
 
 #pragma region Award checks
 
+/** The number of guests in the park whose newest thought is a recent one of the given type. */
+static sint32 award_count_recent_thoughts(const park_guest_statistics * statistics, uint8 thoughtType)
+{
+    return (sint32)statistics->recent_thoughts[thoughtType];
+}
+
+static sint32 award_count_untidy_thoughts(const park_guest_statistics * statistics)
+{
+    return award_count_recent_thoughts(statistics, PEEP_THOUGHT_TYPE_BAD_LITTER) +
+        award_count_recent_thoughts(statistics, PEEP_THOUGHT_TYPE_PATH_DISGUSTING) +
+        award_count_recent_thoughts(statistics, PEEP_THOUGHT_TYPE_VANDALISM);
+}
+
 /** More than 1/16 of the total guests must be thinking untidy thoughts. */
 static bool award_is_deserved_most_untidy(sint32 awardType, sint32 activeAwardTypes)
 {
-    uint16 spriteIndex;
-    rct_peep * peep;
-    sint32 negativeCount;
-
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_BEAUTIFUL))
         return 0;
     if (activeAwardTypes & (1 << PARK_AWARD_BEST_STAFF))
@@ -93,61 +103,21 @@ static bool award_is_deserved_most_untidy(sint32 awardType, sint32 activeAwardTy
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_TIDY))
         return 0;
 
-    negativeCount = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 > 5)
-            continue;
-
-        if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-        {
-            negativeCount++;
-        }
-    }
-
+    sint32 negativeCount = award_count_untidy_thoughts(park_statistics_get());
     return (negativeCount > gNumGuestsInPark / 16);
 }
 
 /** More than 1/64 of the total guests must be thinking tidy thoughts and less than 6 guests thinking untidy thoughts. */
 static bool award_is_deserved_most_tidy(sint32 awardType, sint32 activeAwardTypes)
 {
-    uint16 spriteIndex;
-    rct_peep * peep;
-    sint32 positiveCount;
-    sint32 negativeCount;
-
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_UNTIDY))
         return 0;
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_DISAPPOINTING))
         return 0;
 
-    positiveCount = 0;
-    negativeCount = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 > 5)
-            continue;
-
-        if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VERY_CLEAN)
-            positiveCount++;
-
-        if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM
-            )
-        {
-            negativeCount++;
-        }
-    }
-
+    const park_guest_statistics * statistics = park_statistics_get();
+    sint32 positiveCount = award_count_recent_thoughts(statistics, PEEP_THOUGHT_TYPE_VERY_CLEAN);
+    sint32 negativeCount = award_count_untidy_thoughts(statistics);
     return (negativeCount <= 5 && positiveCount > gNumGuestsInPark / 64);
 }
 
@@ -207,37 +177,14 @@ static bool award_is_deserved_best_value(sint32 awardType, sint32 activeAwardTyp
 /** More than 1/128 of the total guests must be thinking scenic thoughts and fewer than 16 untidy thoughts. */
 static bool award_is_deserved_most_beautiful(sint32 awardType, sint32 activeAwardTypes)
 {
-    uint16 spriteIndex;
-    rct_peep * peep;
-    sint32 positiveCount;
-    sint32 negativeCount;
-
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_UNTIDY))
         return 0;
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_DISAPPOINTING))
         return 0;
 
-    positiveCount = 0;
-    negativeCount = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 > 5)
-            continue;
-
-        if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_SCENERY)
-            positiveCount++;
-
-        if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-            peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-        {
-            negativeCount++;
-        }
-    }
-
+    const park_guest_statistics * statistics = park_statistics_get();
+    sint32 positiveCount = award_count_recent_thoughts(statistics, PEEP_THOUGHT_TYPE_SCENERY);
+    sint32 negativeCount = award_count_untidy_thoughts(statistics);
     return (negativeCount <= 15 && positiveCount > gNumGuestsInPark / 128);
 }
 
@@ -260,19 +207,10 @@ static bool award_is_deserved_worst_value(sint32 awardType, sint32 activeAwardTy
 /** No more than 2 people who think the vandalism is bad and no crashes. */
 static bool award_is_deserved_safest(sint32 awardType, sint32 activeAwardTypes)
 {
-    sint32 i, peepsWhoDislikeVandalism;
-    uint16 spriteIndex;
-    rct_peep * peep;
-    Ride     * ride;
+    sint32 i;
+    Ride * ride;
 
-    peepsWhoDislikeVandalism = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-        if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-            peepsWhoDislikeVandalism++;
-    }
+    sint32 peepsWhoDislikeVandalism = award_count_recent_thoughts(park_statistics_get(), PEEP_THOUGHT_TYPE_VANDALISM);
 
     if (peepsWhoDislikeVandalism > 2)
         return 0;
@@ -290,27 +228,18 @@ static bool award_is_deserved_safest(sint32 awardType, sint32 activeAwardTypes)
 /** All staff types, at least 20 staff, one staff per 32 peeps. */
 static bool award_is_deserved_best_staff(sint32 awardType, sint32 activeAwardTypes)
 {
-    uint16 spriteIndex;
-    rct_peep * peep;
-    sint32 peepCount, staffCount;
-    sint32 staffTypeFlags;
-
     if (activeAwardTypes & (1 << PARK_AWARD_MOST_UNTIDY))
         return 0;
 
-    peepCount      = 0;
-    staffCount     = 0;
-    staffTypeFlags = 0;
-    FOR_ALL_PEEPS(spriteIndex, peep)
+    const park_guest_statistics * statistics = park_statistics_get();
+    sint32 peepCount      = (sint32)statistics->guests;
+    sint32 staffCount     = (sint32)statistics->staff;
+    sint32 staffTypeFlags = 0;
+    for (sint32 staffType = 0; staffType < STAFF_TYPE_COUNT; staffType++)
     {
-        if (peep->type == PEEP_TYPE_STAFF)
+        if (statistics->staff_of_type[staffType] != 0)
         {
-            staffCount++;
-            staffTypeFlags |= (1 << peep->staff_type);
-        }
-        else
-        {
-            peepCount++;
+            staffTypeFlags |= (1 << staffType);
         }
     }
 
@@ -325,8 +254,6 @@ static bool award_is_deserved_best_food(sint32 awardType, sint32 activeAwardType
     uint64 shopTypes;
     Ride           * ride;
     rct_ride_entry * rideEntry;
-    uint16 spriteIndex;
-    rct_peep * peep;
 
     if (activeAwardTypes & (1 << PARK_AWARD_WORST_FOOD))
         return 0;
@@ -358,15 +285,7 @@ static bool award_is_deserved_best_food(sint32 awardType, sint32 activeAwardType
         return 0;
 
     // Count hungry peeps
-    hungryPeeps = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-            hungryPeeps++;
-    }
+    hungryPeeps = award_count_recent_thoughts(park_statistics_get(), PEEP_THOUGHT_TYPE_HUNGRY);
 
     return (hungryPeeps <= 12);
 }
@@ -378,8 +297,6 @@ static bool award_is_deserved_worst_food(sint32 awardType, sint32 activeAwardTyp
     uint64 shopTypes;
     Ride           * ride;
     rct_ride_entry * rideEntry;
-    uint16 spriteIndex;
-    rct_peep * peep;
 
     if (activeAwardTypes & (1 << PARK_AWARD_BEST_FOOD))
         return 0;
@@ -411,15 +328,7 @@ static bool award_is_deserved_worst_food(sint32 awardType, sint32 activeAwardTyp
         return 0;
 
     // Count hungry peeps
-    hungryPeeps = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-            hungryPeeps++;
-    }
+    hungryPeeps = award_count_recent_thoughts(park_statistics_get(), PEEP_THOUGHT_TYPE_HUNGRY);
 
     return (hungryPeeps > 15);
 }
@@ -429,8 +338,6 @@ static bool award_is_deserved_best_restrooms(sint32 awardType, sint32 activeAwar
 {
     uint32 i, numRestrooms, guestsWhoNeedRestroom;
     Ride * ride;
-    uint16 spriteIndex;
-    rct_peep * peep;
 
     // Count open restrooms
     numRestrooms = 0;
@@ -449,15 +356,7 @@ static bool award_is_deserved_best_restrooms(sint32 awardType, sint32 activeAwar
         return 0;
 
     // Count number of guests who are thinking they need the restroom
-    guestsWhoNeedRestroom = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BATHROOM)
-            guestsWhoNeedRestroom++;
-    }
+    guestsWhoNeedRestroom = award_count_recent_thoughts(park_statistics_get(), PEEP_THOUGHT_TYPE_BATHROOM);
 
     return (guestsWhoNeedRestroom <= 16);
 }
@@ -590,21 +489,9 @@ static bool award_is_deserved_most_dazzling_ride_colours(sint32 awardType, sint3
 /** At least 10 peeps and more than 1/64 of total guests are lost or can't find something. */
 static bool award_is_deserved_most_confusing_layout(sint32 awardType, sint32 activeAwardTypes)
 {
-    uint32 peepsCounted, peepsLost;
-    uint16 spriteIndex;
-    rct_peep * peep;
-
-    peepsCounted = 0;
-    peepsLost    = 0;
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->outside_of_park != 0)
-            continue;
-
-        peepsCounted++;
-        if (peep->thoughts[0].var_2 <= 5 && (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_LOST || peep->thoughts[0].type == PEEP_THOUGHT_TYPE_CANT_FIND))
-            peepsLost++;
-    }
+    const park_guest_statistics * statistics = park_statistics_get();
+    uint32 peepsCounted = statistics->guests_in_park;
+    uint32 peepsLost    = statistics->recent_thoughts[PEEP_THOUGHT_TYPE_LOST] + statistics->recent_thoughts[PEEP_THOUGHT_TYPE_CANT_FIND];
 
     return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
 }
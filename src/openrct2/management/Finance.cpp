@@ -23,6 +23,7 @@
 #include "../ride/ride.h"
 #include "../util/util.h"
 #include "../world/park.h"
+#include "../world/ParkStatistics.h"
 #include "../world/sprite.h"
 #include "Finance.h"
 
@@ -100,17 +101,20 @@ void finance_payment(money32 amount, rct_expenditure_type type)
  */
 void finance_pay_wages()
 {
-    rct_peep * peep;
-    uint16 spriteIndex;
-
     if (gParkFlags & PARK_FLAGS_NO_MONEY)
     {
         return;
     }
 
-    FOR_ALL_STAFF(spriteIndex, peep)
+    // Paying each staff type at once gives the same totals as paying every staff member in turn
+    const park_guest_statistics * statistics = park_statistics_get();
+    for (sint32 staffType = 0; staffType < STAFF_TYPE_COUNT; staffType++)
     {
-        finance_payment(wage_table[peep->staff_type] / 4, RCT_EXPENDITURE_TYPE_WAGES);
+        uint32 staffCount = statistics->staff_of_type[staffType];
+        if (staffCount != 0)
+        {
+            finance_payment((wage_table[staffType] / 4) * (money32)staffCount, RCT_EXPENDITURE_TYPE_WAGES);
+        }
     }
 }
 
@@ -247,12 +251,10 @@ void finance_update_daily_profit()
     if (!(gParkFlags & PARK_FLAGS_NO_MONEY))
     {
         // Staff costs
-        uint16 sprite_index;
-        rct_peep * peep;
-
-        FOR_ALL_STAFF(sprite_index, peep)
+        const park_guest_statistics * statistics = park_statistics_get();
+        for (sint32 staffType = 0; staffType < STAFF_TYPE_COUNT; staffType++)
         {
-            current_profit -= wage_table[peep->staff_type];
+            current_profit -= wage_table[staffType] * (money32)statistics->staff_of_type[staffType];
         }
 
         // Research costs
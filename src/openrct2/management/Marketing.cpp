@@ -21,6 +21,7 @@
 #include "../localisation/localisation.h"
 #include "../ride/ride.h"
 #include "../ride/ride_data.h"
+#include "../world/ParkStatistics.h"
 #include "../cheats.h"
 #include "Finance.h"
 #include "Marketing.h"
@@ -145,6 +146,7 @@ void marketing_set_guest_campaign(rct_peep * peep, sint32 campaign)
         peep->peep_is_lost_countdown   = 240;
         break;
     }
+    park_statistics_update_peep(peep);
 }
 
 void game_command_callback_marketing_start_campaign(sint32 eax, sint32 ebx, sint32 ecx, sint32 edx, sint32 esi, sint32 edi, sint32 ebp)
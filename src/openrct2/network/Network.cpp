@@ -46,6 +46,7 @@ static sint32 _pickup_peep_old_x = LOCATION_NULL;
 #include "../core/Json.hpp"
 #include "../core/Math.hpp"
 #include "../core/MemoryStream.h"
+#include "../core/Profiling.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../core/Util.hpp"
@@ -76,6 +77,11 @@ using namespace OpenRCT2;
 
 static Network gNetwork;
 
+// Number of map snapshots the server keeps for sending deltas to rejoining clients
+#define NETWORK_MAP_SNAPSHOT_HISTORY 3
+#define NETWORK_MAP_HEADER_ZLIB "open2_sv6_zlib"
+#define NETWORK_MAP_HEADER_DELTA "open2_sv6_delta"
+
 enum {
     SERVER_EVENT_PLAYER_JOINED,
     SERVER_EVENT_PLAYER_DISCONNECTED,
@@ -193,6 +199,7 @@ void Network::Close()
 
     client_connection_list.clear();
     game_command_queue.clear();
+    _mapSnapshots.clear();
     player_list.clear();
     group_list.clear();
 
@@ -389,6 +396,7 @@ uint8 Network::GetPlayerID()
 
 void Network::Update()
 {
+    PROFILE_SCOPE("Network::Update");
     _closeLock = true;
 
     switch (GetMode()) {
@@ -993,6 +1001,8 @@ void Network::Client_Send_OBJECTS(const std::vector<std::string> &objects)
         log_verbose("client requests object %s", objects[i].c_str());
         packet->Write((const uint8 *)objects[i].c_str(), 8);
     }
+    // Lets the server send the map as a delta if we still have the map from a previous connection
+    *packet << _clientMapSnapshotId;
     server_connection->QueuePacket(std::move(packet));
 }
 
@@ -1046,74 +1056,176 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
         // TODO: fix it so custom objects negotiation is performed even in this case.
         IObjectManager * objManager = GetObjectManager();
         objects = objManager->GetPackableObjects();
+        // A new map has been loaded, so none of the previous snapshots are of any use
+        _mapSnapshots.clear();
+    }
+
+    // Find the client's snapshot before taking a new one, which could push it out of the history
+    std::shared_ptr<MapSnapshot> baseSnapshot;
+    if (connection && connection->MapSnapshotId != 0) {
+        auto it = std::find_if(_mapSnapshots.begin(), _mapSnapshots.end(),
+            [connection](const std::shared_ptr<MapSnapshot> &s) { return s->Id == connection->MapSnapshotId; });
+        if (it != _mapSnapshots.end()) {
+            baseSnapshot = *it;
+        }
     }
 
-    size_t out_size;
-    uint8 * header = save_for_network(out_size, objects);
-    if (header == nullptr) {
+    auto snapshot = GetMapSnapshot(objects);
+    if (snapshot == nullptr) {
         if (connection) {
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
             connection->Socket->Disconnect();
         }
         return;
     }
+
+    const std::vector<uint8> * payload = &snapshot->Payload;
+    std::vector<uint8> delta;
+    if (baseSnapshot != nullptr) {
+        delta = CreateMapDelta(*baseSnapshot, *snapshot);
+        if (!delta.empty() && delta.size() < payload->size()) {
+            log_verbose("Sending map as a delta of %u bytes instead of %u bytes", delta.size(), payload->size());
+            payload = &delta;
+        }
+    }
+
+    size_t out_size = payload->size();
     size_t chunksize = 65000;
     for (size_t i = 0; i < out_size; i += chunksize) {
         size_t datasize = Math::Min(chunksize, out_size - i);
         std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
         *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)out_size << (uint32)i;
-        packet->Write(&header[i], datasize);
+        packet->Write(&(*payload)[i], datasize);
         if (connection) {
             connection->QueuePacket(std::move(packet));
         } else {
             SendPacketToClients(*packet);
         }
     }
-    free(header);
 }
 
-uint8 * Network::save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const
+std::shared_ptr<Network::MapSnapshot> Network::GetMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects)
+{
+    // The map can only change between ticks or through a game command, so clients joining in the same tick share
+    // the snapshot rather than saving and compressing the park again for each of them.
+    if (!_mapSnapshots.empty()) {
+        auto latest = _mapSnapshots.front();
+        if (latest->Tick == gCurrentTicks && latest->CommandCount == _serverCommandCount && latest->Objects == objects) {
+            log_verbose("Reusing map snapshot of tick %u", latest->Tick);
+            return latest;
+        }
+    }
+
+    auto snapshot = CreateMapSnapshot(objects);
+    if (snapshot != nullptr) {
+        _mapSnapshots.push_front(snapshot);
+        while (_mapSnapshots.size() > NETWORK_MAP_SNAPSHOT_HISTORY) {
+            _mapSnapshots.pop_back();
+        }
+    }
+    return snapshot;
+}
+
+std::shared_ptr<Network::MapSnapshot> Network::CreateMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects) const
 {
-    uint8 * header = nullptr;
-    out_size = 0;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
     auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects)) {
+    bool saved = SaveMap(&ms, objects);
+    gUseRLE = RLEState;
+    if (!saved) {
         log_warning("Failed to export map.");
         return nullptr;
     }
-    gUseRLE = RLEState;
 
-    const void * data = ms.GetData();
-    sint32 size = ms.GetLength();
+    auto snapshot = std::make_shared<MapSnapshot>();
+    snapshot->Tick = gCurrentTicks;
+    snapshot->CommandCount = _serverCommandCount;
+    snapshot->Objects = objects;
 
-    uint8 *compressed = util_zlib_deflate((const uint8 *)data, size, &out_size);
-    if (compressed != nullptr)
-    {
-        header = (uint8 *)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char *)header) + 1; // account for null terminator
-        header = (uint8 *)realloc(header, header_len + out_size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        } else {
-            memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
-        }
+    const uint8 * data = (const uint8 *)ms.GetData();
+    size_t size = ms.GetLength();
+    snapshot->Data.assign(data, data + size);
+    snapshot->Id = util_zlib_crc32(data, size);
+
+    size_t compressedSize = 0;
+    uint8 * compressed = util_zlib_deflate(data, size, &compressedSize);
+    if (compressed != nullptr) {
+        size_t header_len = sizeof(NETWORK_MAP_HEADER_ZLIB); // includes the null terminator
+        snapshot->Payload.resize(header_len + compressedSize);
+        memcpy(snapshot->Payload.data(), NETWORK_MAP_HEADER_ZLIB, header_len);
+        memcpy(snapshot->Payload.data() + header_len, compressed, compressedSize);
         free(compressed);
+        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, snapshot->Payload.size());
     } else {
         log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8 *)malloc(size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", size);
-        } else {
-            out_size = size;
-            memcpy(header, data, size);
-        }
+        snapshot->Payload = snapshot->Data;
     }
-    return header;
+    return snapshot;
+}
+
+std::vector<uint8> Network::CreateMapDelta(const MapSnapshot &base, const MapSnapshot &snapshot) const
+{
+    // XOR against the base leaves zeros wherever the park has not changed, which compresses to almost nothing
+    std::vector<uint8> difference(snapshot.Data);
+    size_t commonLength = std::min(base.Data.size(), difference.size());
+    for (size_t i = 0; i < commonLength; i++) {
+        difference[i] ^= base.Data[i];
+    }
+
+    size_t compressedSize = 0;
+    uint8 * compressed = util_zlib_deflate(difference.data(), difference.size(), &compressedSize);
+    if (compressed == nullptr) {
+        return std::vector<uint8>();
+    }
+
+    // Header, base snapshot id, snapshot id, uncompressed size, compressed difference
+    uint32 fields[] = { base.Id, snapshot.Id, (uint32)snapshot.Data.size() };
+    size_t header_len = sizeof(NETWORK_MAP_HEADER_DELTA);
+    std::vector<uint8> delta(header_len + sizeof(fields) + compressedSize);
+    memcpy(delta.data(), NETWORK_MAP_HEADER_DELTA, header_len);
+    memcpy(delta.data() + header_len, fields, sizeof(fields));
+    memcpy(delta.data() + header_len + sizeof(fields), compressed, compressedSize);
+    free(compressed);
+    return delta;
+}
+
+bool Network::ApplyMapDelta(const uint8 * delta, size_t deltaSize, std::vector<uint8> &data)
+{
+    uint32 fields[3];
+    if (deltaSize < sizeof(fields)) {
+        return false;
+    }
+    memcpy(fields, delta, sizeof(fields));
+    uint32 baseId = fields[0];
+    uint32 id = fields[1];
+    uint32 size = fields[2];
+    if (_clientMapSnapshot.empty() || baseId != _clientMapSnapshotId) {
+        log_warning("Server sent a map delta against a snapshot we do not have.");
+        return false;
+    }
+
+    size_t differenceSize = size;
+    uint8 * difference = util_zlib_inflate((uint8 *)delta + sizeof(fields), deltaSize - sizeof(fields), &differenceSize);
+    if (difference == nullptr) {
+        return false;
+    }
+    data.assign(difference, difference + differenceSize);
+    free(difference);
+    if (data.size() != size) {
+        return false;
+    }
+
+    size_t commonLength = std::min(_clientMapSnapshot.size(), data.size());
+    for (size_t i = 0; i < commonLength; i++) {
+        data[i] ^= _clientMapSnapshot[i];
+    }
+    if (util_zlib_crc32(data.data(), data.size()) != id) {
+        log_warning("Map delta does not produce the map sent by the server.");
+        return false;
+    }
+    return true;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1146,6 +1258,7 @@ void Network::Server_Send_GAMECMD(uint32 eax, uint32 ebx, uint32 ecx, uint32 edx
     *packet << (uint32)NETWORK_COMMAND_GAMECMD << (uint32)gCurrentTicks << eax << (ebx | GAME_COMMAND_FLAG_NETWORKED)
             << ecx << edx << esi << edi << ebp << playerid << callback;
     SendPacketToClients(*packet, false, true);
+    _serverCommandCount++;
 }
 
 void Network::Client_Send_GAME_ACTION(const GameAction *action)
@@ -1180,6 +1293,7 @@ void Network::Server_Send_GAME_ACTION(const GameAction *action)
     *packet << (uint32)NETWORK_COMMAND_GAME_ACTION << (uint32)gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
+    _serverCommandCount++;
 }
 
 void Network::Server_Send_TICK()
@@ -1812,6 +1926,7 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
             connection.RequestedObjects.push_back(item);
         }
     }
+    packet >> connection.MapSnapshotId;
 
     const char * player_name = (const char *) connection.Player->Name.c_str();
     Server_Send_MAP(&connection);
@@ -1929,27 +2044,43 @@ void Network::Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& pa
     memcpy(&chunk_buffer[offset], (void*)packet.Read(chunksize), chunksize);
     if (offset + chunksize == size) {
         window_network_status_close();
-        bool has_to_free = false;
-        uint8 *data = &chunk_buffer[0];
-        size_t data_size = size;
+        std::vector<uint8> data;
         // zlib-compressed
-        if (strcmp("open2_sv6_zlib", (char *)&chunk_buffer[0]) == 0)
+        if (strcmp(NETWORK_MAP_HEADER_ZLIB, (char *)&chunk_buffer[0]) == 0)
         {
             log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
+            size_t header_len = sizeof(NETWORK_MAP_HEADER_ZLIB);
+            size_t data_size = size;
+            uint8 * inflated = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
+            if (inflated == nullptr)
             {
                 log_warning("Failed to decompress data sent from server.");
                 Close();
                 return;
             }
+            data.assign(inflated, inflated + data_size);
+            free(inflated);
+        }
+        // Difference to the map we received on a previous connection
+        else if (strcmp(NETWORK_MAP_HEADER_DELTA, (char *)&chunk_buffer[0]) == 0)
+        {
+            log_verbose("Received sv6 map delta");
+            size_t header_len = sizeof(NETWORK_MAP_HEADER_DELTA);
+            if (!ApplyMapDelta(&chunk_buffer[header_len], size - header_len, data))
+            {
+                log_warning("Failed to apply map delta sent from server.");
+                // Request the whole map next time
+                _clientMapSnapshot.clear();
+                _clientMapSnapshotId = 0;
+                Close();
+                return;
+            }
         } else {
             log_verbose("Assuming received map is in plain sv6 format");
+            data.assign(chunk_buffer.begin(), chunk_buffer.begin() + size);
         }
 
-        auto ms = MemoryStream(data, data_size);
+        auto ms = MemoryStream(data.data(), data.size());
         if (LoadMap(&ms))
         {
             game_load_init();
@@ -1965,15 +2096,17 @@ void Network::Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& pa
 
             // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
             fix_invalid_vehicle_sprite_sizes();
+
+            // Keep the map so that rejoining the server only needs the difference to it
+            _clientMapSnapshotId = util_zlib_crc32(data.data(), data.size());
+            _clientMapSnapshot = std::move(data);
         }
         else
         {
             //Something went wrong, game is not loaded. Return to main screen.
             game_do_command(0, GAME_COMMAND_FLAG_APPLY, 0, 0, GAME_COMMAND_LOAD_OR_QUIT, 1, 0);
-        }
-        if (has_to_free)
-        {
-            free(data);
+            _clientMapSnapshot.clear();
+            _clientMapSnapshotId = 0;
         }
     }
 }
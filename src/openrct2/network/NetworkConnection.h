@@ -44,6 +44,7 @@ public:
     NetworkKey                                  Key;
     std::vector<uint8>                          Challenge;
     std::vector<const ObjectRepositoryItem *>   RequestedObjects;
+    uint32                                      MapSnapshotId   = 0;
 
     NetworkConnection();
     ~NetworkConnection();
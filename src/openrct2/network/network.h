@@ -51,7 +51,7 @@ typedef struct GameAction GameAction;
 // This define specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "16"
+#define NETWORK_STREAM_VERSION "17"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 #ifdef __cplusplus
@@ -194,6 +194,23 @@ private:
     bool LoadMap(IStream * stream);
     bool SaveMap(IStream * stream, const std::vector<const ObjectRepositoryItem *> &objects) const;
 
+    // A saved map as sent to joining clients, kept so that clients joining in the same tick can share it and
+    // rejoining clients can be sent the difference to the snapshot they already have.
+    struct MapSnapshot
+    {
+        uint32 Tick = 0;
+        uint32 CommandCount = 0;
+        uint32 Id = 0;
+        std::vector<const ObjectRepositoryItem *> Objects;
+        std::vector<uint8> Data;
+        std::vector<uint8> Payload;
+    };
+
+    std::shared_ptr<MapSnapshot> GetMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects);
+    std::shared_ptr<MapSnapshot> CreateMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects) const;
+    std::vector<uint8> CreateMapDelta(const MapSnapshot &base, const MapSnapshot &snapshot) const;
+    bool ApplyMapDelta(const uint8 * delta, size_t deltaSize, std::vector<uint8> &data);
+
     struct GameCommand
     {
         GameCommand(uint32 t, uint32* args, uint8 p, uint8 cb, uint32 id) {
@@ -244,6 +261,10 @@ private:
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::multiset<GameCommand> game_command_queue;
     std::vector<uint8> chunk_buffer;
+    std::list<std::shared_ptr<MapSnapshot>> _mapSnapshots;
+    uint32 _serverCommandCount = 0;
+    std::vector<uint8> _clientMapSnapshot;
+    uint32 _clientMapSnapshotId = 0;
     std::string _password;
     bool _desynchronised = false;
     INetworkServerAdvertiser * _advertiser = nullptr;
@@ -289,8 +310,6 @@ private:
     void Server_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
-
-    uint8 * save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const;
 };
 
 #endif // __cplusplus
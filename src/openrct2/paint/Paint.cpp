@@ -19,12 +19,20 @@
 #include "../localisation/localisation.h"
 #include "../config/Config.h"
 #include "../interface/viewport.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
+#include "../core/Profiling.h"
+#include "../drawing/NewDrawing.h"
 #include "map_element/map_element.h"
 #include "sprite/sprite.h"
 #include "supports.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 // Global for paint clipping height
 uint8 gClipHeight = 128; // Default to middle value
@@ -36,7 +44,23 @@ const uint32 construction_markers[] =
 };
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+
+struct PaintSessionJob
+{
+    paint_session *         Session;
+    uint32                  ViewFlags;
+    paint_session_callback  Finish;
+};
+
+// Sessions are pooled so several columns can be painted at once, gPaintSession is the first of them
+static std::vector<paint_session *> _freePaintSessions = { &gPaintSession };
+static std::deque<PaintSessionJob>  _finishedPaintJobs;
+static size_t                       _outstandingPaintJobs;
+static std::mutex                   _paintSessionMutex;
+static std::condition_variable      _paintJobFinished;
+static std::unique_ptr<JobPool>     _paintJobPool;
+static paint_arena_stats            _paintArenaStats;
+static uint64                       _paintPhaseTimes[PAINT_PHASE_COUNT];
 
 #ifndef NO_RCT2
 #define _paintQuadrants (RCT2_ADDRESS(0x00F1A50C, paint_struct*))
@@ -63,6 +87,14 @@ static const uint8 BoundBoxDebugColours[] =
 
 bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
+bool gPaintPhaseTimingEnabled;
+
+const char * const PaintPhaseNames[PAINT_PHASE_COUNT] =
+{
+    "generate",
+    "arrange",
+    "draw",
+};
 
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi);
 static void paint_attached_ps(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
@@ -73,8 +105,11 @@ static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
 {
     session->Unk140E9A8 = dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->CurrentPaintChunk = &session->FirstPaintChunk;
+    session->EndOfPaintStructArray = &session->FirstPaintChunk.Entries[PAINT_ENTRY_CHUNK_SIZE];
+    session->NextFreePaintStruct = session->FirstPaintChunk.Entries;
+    session->PaintEntriesInFullChunks = 0;
+    session->DroppedPaintEntries = 0;
     session->UnkF1AD28 = NULL;
     session->UnkF1AD2C = NULL;
     for (sint32 i = 0; i < MAX_PAINT_QUADRANTS; i++)
@@ -88,6 +123,40 @@ static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
     session->WoodenSupportsPrependTo = NULL;
     session->CurrentlyDrawnItem = NULL;
     session->SurfaceElement = NULL;
+    for (sint32 i = 0; i < PAINT_PHASE_COUNT; i++)
+    {
+        session->PhaseTimes[i] = 0;
+    }
+}
+
+/**
+ * Makes NextFreePaintStruct point at a free entry, moving on to the next chunk when the current
+ * one is full. Chunks are only allocated when a session needs more entries than ever before.
+ */
+static bool paint_session_reserve_entry(paint_session * session)
+{
+    if (session->NextFreePaintStruct < session->EndOfPaintStructArray)
+    {
+        return true;
+    }
+
+    paint_entry_chunk * chunk = session->CurrentPaintChunk;
+    if (chunk->Next == nullptr)
+    {
+        if (session->PaintChunkCount + 1 >= PAINT_ENTRY_MAX_CHUNKS)
+        {
+            session->DroppedPaintEntries++;
+            return false;
+        }
+        chunk->Next = new paint_entry_chunk();
+        session->PaintChunkCount++;
+    }
+
+    session->PaintEntriesInFullChunks += PAINT_ENTRY_CHUNK_SIZE;
+    session->CurrentPaintChunk = chunk->Next;
+    session->NextFreePaintStruct = chunk->Next->Entries;
+    session->EndOfPaintStructArray = &chunk->Next->Entries[PAINT_ENTRY_CHUNK_SIZE];
+    return true;
 }
 
 static void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
@@ -106,7 +175,7 @@ static void paint_session_add_ps_to_quadrant(paint_session * session, paint_stru
 */
 static paint_struct * sub_9819_c(paint_session * session, uint32 image_id, LocationXYZ16 offset, LocationXYZ16 boundBoxSize, LocationXYZ16 boundBoxOffset, uint8 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) return NULL;
+    if (!paint_session_reserve_entry(session)) return NULL;
     paint_struct * ps = &session->NextFreePaintStruct->basic;
 
     ps->image_id = image_id;
@@ -200,6 +269,7 @@ static paint_struct * sub_9819_c(paint_session * session, uint32 image_id, Locat
 */
 void paint_session_generate(paint_session * session)
 {
+    PROFILE_FUNCTION();
     rct_drawpixelinfo * dpi = session->Unk140E9A8;
     LocationXY16 mapTile =
     {
@@ -306,39 +376,71 @@ void paint_session_generate(paint_session * session)
     }
 }
 
-static bool is_bbox_intersecting(uint8 rotation, const paint_struct_bound_box& initialBBox,
-    const paint_struct_bound_box& currentBBox)
+template<uint8 TRotation>
+static bool is_bbox_intersecting(const paint_struct_bound_box& initialBBox, const paint_struct_bound_box& currentBBox)
 {
-    bool result = false;
-    switch (rotation) {
+    switch (TRotation) {
     case 0:
-        if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end >= currentBBox.x
-            && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x < currentBBox.x_end))
-            result = true;
-        break;
+        return initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end >= currentBBox.x
+            && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x < currentBBox.x_end);
     case 1:
-        if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end < currentBBox.x
-            && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
-            result = true;
-        break;
+        return initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end < currentBBox.x
+            && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x >= currentBBox.x_end);
     case 2:
-        if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end < currentBBox.x
-            && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
-            result = true;
-        break;
+        return initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end < currentBBox.x
+            && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x >= currentBBox.x_end);
     case 3:
-        if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end >= currentBBox.x
-            && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x < currentBBox.x_end))
-            result = true;
-        break;
+        return initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end >= currentBBox.x
+            && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x < currentBBox.x_end);
     }
-    return result;
+    return false;
 }
 
-paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+/**
+ * Whether a struct with the given bounding box could be intersecting with any struct whose bounding box
+ * starts within the given range. Used to skip scans that can not move anything.
+ */
+template<uint8 TRotation>
+static bool is_bbox_intersecting_any(const paint_struct_bound_box& initialBBox, const paint_struct_bound_box& minBBox,
+    const paint_struct_bound_box& maxBBox)
+{
+    bool xInRange = (TRotation == 0 || TRotation == 3) ? initialBBox.x_end >= minBBox.x : initialBBox.x_end < maxBBox.x;
+    bool yInRange = (TRotation == 0 || TRotation == 1) ? initialBBox.y_end >= minBBox.y : initialBBox.y_end < maxBBox.y;
+    return initialBBox.z_end >= minBBox.z && xInRange && yInRange;
+}
+
+static paint_struct_bound_box paint_struct_get_bound_box(const paint_struct * ps)
 {
+    return
+    {
+        ps->bound_box_x,
+        ps->bound_box_y,
+        ps->bound_box_z,
+        ps->bound_box_x_end,
+        ps->bound_box_y_end,
+        ps->bound_box_z_end
+    };
+}
+
+struct paint_arrange_entry
+{
+    paint_struct_bound_box BoundBox;
+    uint8 Flags;
+    paint_struct * Struct;
+};
+
+/**
+ * Sorts the structs of a quadrant and the one in front of it. This gives the same order as the
+ * original linked list insertion sort, but works on a contiguous copy of the structs taking part
+ * so the quadratic part of the sort does not chase list pointers.
+ */
+template<uint8 TRotation>
+static paint_struct * paint_arrange_structs_helper_rotation(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+{
+    // Sort buffer is reused between calls as arranging may run on several threads
+    static thread_local std::vector<paint_arrange_entry> entries;
+
     paint_struct * ps;
-    paint_struct * ps_temp;
     do
     {
         ps = ps_next;
@@ -349,83 +451,99 @@ paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadr
     // Cache the last visited node so we don't have to walk the whole list again
     paint_struct * ps_cache = ps;
 
-    ps_temp = ps;
-    do {
-        ps = ps->next_quadrant_ps;
-        if (ps == NULL) break;
-
-        if (ps->quadrant_index > quadrantIndex + 1)
+    // Flag the structs of this quadrant and the next one and collect everything up to the first
+    // struct of a later quadrant
+    entries.clear();
+    paint_struct_bound_box minBBox = { UINT16_MAX, UINT16_MAX, UINT16_MAX, 0, 0, 0 };
+    paint_struct_bound_box maxBBox = { 0, 0, 0, 0, 0, 0 };
+    paint_struct * psEnd = ps->next_quadrant_ps;
+    bool marking = true;
+    for (; psEnd != NULL; psEnd = psEnd->next_quadrant_ps)
+    {
+        if (marking)
         {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+            if (psEnd->quadrant_index > quadrantIndex + 1)
+            {
+                psEnd->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+                marking = false;
+            }
+            else if (psEnd->quadrant_index == quadrantIndex + 1)
+            {
+                psEnd->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
+            else if (psEnd->quadrant_index == quadrantIndex)
+            {
+                psEnd->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
         }
-        else if (ps->quadrant_index == quadrantIndex + 1)
+        if (psEnd->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER)
         {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+            break;
         }
-        else if (ps->quadrant_index == quadrantIndex)
+
+        paint_arrange_entry entry = { paint_struct_get_bound_box(psEnd), psEnd->quadrant_flags, psEnd };
+        if (entry.Flags & PAINT_QUADRANT_FLAG_NEXT)
         {
-            ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+            minBBox.x = std::min(minBBox.x, entry.BoundBox.x);
+            minBBox.y = std::min(minBBox.y, entry.BoundBox.y);
+            minBBox.z = std::min(minBBox.z, entry.BoundBox.z);
+            maxBBox.x = std::max(maxBBox.x, entry.BoundBox.x);
+            maxBBox.y = std::max(maxBBox.y, entry.BoundBox.y);
         }
-    } while (ps->quadrant_index <= quadrantIndex + 1);
-    ps = ps_temp;
+        entries.push_back(entry);
+    }
 
-    uint8 rotation = get_current_rotation();
+    // Each identical struct moves every following next struct that it intersects to just in front of it
+    const size_t count = entries.size();
+    paint_arrange_entry * data = entries.data();
+    size_t position = 0;
     while (true)
     {
-        while (true)
+        while (position < count && !(data[position].Flags & PAINT_QUADRANT_FLAG_IDENTICAL))
         {
-            ps_next = ps->next_quadrant_ps;
-            if (ps_next == NULL) return ps_cache;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) return ps_cache;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL) break;
-            ps = ps_next;
+            position++;
         }
-
-        ps_next->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
-        ps_temp = ps;
-
-        const paint_struct_bound_box initialBBox =
+        if (position == count)
         {
-            ps_next->bound_box_x,
-            ps_next->bound_box_y,
-            ps_next->bound_box_z,
-            ps_next->bound_box_x_end,
-            ps_next->bound_box_y_end,
-            ps_next->bound_box_z_end
-        };
-
+            break;
+        }
 
-        while (true)
+        data[position].Flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        const paint_struct_bound_box initialBBox = data[position].BoundBox;
+        if (is_bbox_intersecting_any<TRotation>(initialBBox, minBBox, maxBBox))
         {
-            ps = ps_next;
-            ps_next = ps_next->next_quadrant_ps;
-            if (ps_next == NULL) break;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) break;
-            if (!(ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_NEXT)) continue;
-
-            const paint_struct_bound_box currentBBox =
+            for (size_t i = position + 1; i < count; i++)
             {
-                ps_next->bound_box_x,
-                ps_next->bound_box_y,
-                ps_next->bound_box_z,
-                ps_next->bound_box_x_end,
-                ps_next->bound_box_y_end,
-                ps_next->bound_box_z_end
-            };
-
-            bool compareResult = is_bbox_intersecting(rotation, initialBBox, currentBBox);
-
-            if (compareResult)
-            {
-                ps->next_quadrant_ps = ps_next->next_quadrant_ps;
-                paint_struct *ps_temp2 = ps_temp->next_quadrant_ps;
-                ps_temp->next_quadrant_ps = ps_next;
-                ps_next->next_quadrant_ps = ps_temp2;
-                ps_next = ps;
+                if ((data[i].Flags & PAINT_QUADRANT_FLAG_NEXT) && is_bbox_intersecting<TRotation>(initialBBox, data[i].BoundBox))
+                {
+                    paint_arrange_entry moved = data[i];
+                    memmove(&data[position + 1], &data[position], (i - position) * sizeof(paint_arrange_entry));
+                    data[position] = moved;
+                }
             }
         }
+    }
 
-        ps = ps_temp;
+    paint_struct * previous = ps_cache;
+    for (size_t i = 0; i < count; i++)
+    {
+        paint_struct * current = data[i].Struct;
+        current->quadrant_flags = data[i].Flags;
+        previous->next_quadrant_ps = current;
+        previous = current;
+    }
+    previous->next_quadrant_ps = psEnd;
+    return ps_cache;
+}
+
+paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+{
+    switch (get_current_rotation())
+    {
+    case 0: return paint_arrange_structs_helper_rotation<0>(ps_next, quadrantIndex, flag);
+    case 1: return paint_arrange_structs_helper_rotation<1>(ps_next, quadrantIndex, flag);
+    case 2: return paint_arrange_structs_helper_rotation<2>(ps_next, quadrantIndex, flag);
+    default: return paint_arrange_structs_helper_rotation<3>(ps_next, quadrantIndex, flag);
     }
 }
 
@@ -435,6 +553,7 @@ paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadr
 */
 paint_struct paint_session_arrange(paint_session * session)
 {
+    PROFILE_FUNCTION();
     paint_struct psHead = { 0 };
     paint_struct * ps = &psHead;
     ps->next_quadrant_ps = NULL;
@@ -715,10 +834,19 @@ extern "C"
 {
     paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
     {
-        // Currently limited to just one session at a time
-        assert(!_paintSessionInUse);
-        _paintSessionInUse = true;
-        paint_session * session = &gPaintSession;
+        paint_session * session;
+        {
+            std::lock_guard<std::mutex> lock(_paintSessionMutex);
+            if (_freePaintSessions.empty())
+            {
+                session = new paint_session();
+            }
+            else
+            {
+                session = _freePaintSessions.back();
+                _freePaintSessions.pop_back();
+            }
+        }
 
         paint_session_init(session, dpi);
         return session;
@@ -726,7 +854,139 @@ extern "C"
 
     void paint_session_free(paint_session * session)
     {
-        _paintSessionInUse = false;
+        std::lock_guard<std::mutex> lock(_paintSessionMutex);
+        _paintArenaStats.sessions++;
+        _paintArenaStats.high_water_entries = std::max(_paintArenaStats.high_water_entries, paint_session_get_entry_count(session));
+        _paintArenaStats.dropped_entries += session->DroppedPaintEntries;
+        for (sint32 i = 0; i < PAINT_PHASE_COUNT; i++)
+        {
+            _paintPhaseTimes[i] += session->PhaseTimes[i];
+        }
+        _freePaintSessions.push_back(session);
+    }
+
+    uint32 paint_session_get_entry_count(const paint_session * session)
+    {
+        return session->PaintEntriesInFullChunks + (uint32)(session->NextFreePaintStruct - session->CurrentPaintChunk->Entries);
+    }
+
+    void paint_get_arena_stats(paint_arena_stats * stats)
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionMutex);
+        *stats = _paintArenaStats;
+
+        // Chunks are counted from the idle sessions, which is all of them outside of painting
+        stats->chunks = 0;
+        for (const paint_session * session : _freePaintSessions)
+        {
+            stats->chunks += 1 + session->PaintChunkCount;
+        }
+    }
+
+    void paint_reset_arena_stats()
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionMutex);
+        _paintArenaStats = { 0 };
+    }
+
+    /**
+     * Gets the time spent in each phase by the sessions freed since the times were reset. Arrange and
+     * draw run on the paint workers, so their totals can exceed the wall clock time.
+     */
+    void paint_get_phase_times(uint64 times[PAINT_PHASE_COUNT])
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionMutex);
+        for (sint32 i = 0; i < PAINT_PHASE_COUNT; i++)
+        {
+            times[i] = _paintPhaseTimes[i];
+        }
+    }
+
+    void paint_reset_phase_times()
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionMutex);
+        for (sint32 i = 0; i < PAINT_PHASE_COUNT; i++)
+        {
+            _paintPhaseTimes[i] = 0;
+        }
+    }
+
+    bool paint_session_can_draw_async()
+    {
+        return gConfigGeneral.multithreading && drawing_engine_supports_parallel_drawing();
+    }
+
+    /**
+     * Runs the finish callback of completed jobs on the calling thread and frees their sessions,
+     * waiting for jobs to complete until no more than the given number are outstanding.
+     */
+    static void paint_session_finish_jobs(size_t maxOutstanding)
+    {
+        std::unique_lock<std::mutex> lock(_paintSessionMutex);
+        while (true)
+        {
+            while (!_finishedPaintJobs.empty())
+            {
+                PaintSessionJob job = _finishedPaintJobs.front();
+                _finishedPaintJobs.pop_front();
+                _outstandingPaintJobs--;
+
+                lock.unlock();
+                if (job.Finish != nullptr)
+                {
+                    job.Finish(job.Session, job.ViewFlags);
+                }
+                paint_session_free(job.Session);
+                lock.lock();
+            }
+            if (_outstandingPaintJobs <= maxOutstanding)
+            {
+                break;
+            }
+            _paintJobFinished.wait(lock, []() -> bool
+            {
+                return !_finishedPaintJobs.empty();
+            });
+        }
+    }
+
+    /**
+     * Runs draw for a generated session on a worker thread. The session is freed once finish has been
+     * run on the calling thread, either during a later call or in paint_session_wait_all. Drawing must
+     * only touch the area of the session's dpi and thread safe state.
+     */
+    void paint_session_draw_async(paint_session * session, uint32 viewFlags, paint_session_callback draw, paint_session_callback finish)
+    {
+        if (_paintJobPool == nullptr)
+        {
+            _paintJobPool = std::make_unique<JobPool>();
+        }
+
+        // The caller's dpi is usually reused for the next column
+        session->DPI = *session->Unk140E9A8;
+        session->Unk140E9A8 = &session->DPI;
+
+        // Limit the sessions waiting to be drawn so memory use does not grow with the width of the viewport
+        size_t maxOutstanding = _paintJobPool->GetThreadCount() * 2;
+        paint_session_finish_jobs(maxOutstanding - 1);
+        {
+            std::lock_guard<std::mutex> lock(_paintSessionMutex);
+            _outstandingPaintJobs++;
+        }
+
+        _paintJobPool->AddTask([session, viewFlags, draw, finish]() -> void
+        {
+            draw(session, viewFlags);
+
+            std::lock_guard<std::mutex> lock(_paintSessionMutex);
+            _finishedPaintJobs.push_back({ session, viewFlags, finish });
+            _paintJobFinished.notify_one();
+        });
+    }
+
+    void paint_session_wait_all()
+    {
+        paint_session_finish_jobs(0);
     }
 
     /**
@@ -756,7 +1016,7 @@ extern "C"
         session->UnkF1AD28 = 0;
         session->UnkF1AD2C = NULL;
 
-        if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+        if (!paint_session_reserve_entry(session))
         {
             return NULL;
         }
@@ -1061,7 +1321,7 @@ extern "C"
             return paint_attach_to_previous_ps(session, image_id, x, y);
         }
 
-        if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+        if (!paint_session_reserve_entry(session))
         {
             return false;
         }
@@ -1093,7 +1353,7 @@ extern "C"
     */
     bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
     {
-        if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+        if (!paint_session_reserve_entry(session))
         {
             return false;
         }
@@ -1134,7 +1394,7 @@ extern "C"
     */
     void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
     {
-        if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+        if (!paint_session_reserve_entry(session))
         {
             return;
         }
@@ -66,12 +66,12 @@ void Painter::Paint(IDrawingEngine * de)
 
     if (gConfigGeneral.show_fps)
     {
-        PaintFPS(dpi);
+        PaintFPS(de, dpi);
     }
     gCurrentDrawCount++;
 }
 
-void Painter::PaintFPS(rct_drawpixelinfo * dpi)
+void Painter::PaintFPS(IDrawingEngine * de, rct_drawpixelinfo * dpi)
 {
     sint32 x = _uiContext->GetWidth() / 2;
     sint32 y = 2;
@@ -80,13 +80,23 @@ void Painter::PaintFPS(rct_drawpixelinfo * dpi)
     MeasureFPS();
 
     // Format string
-    utf8 buffer[64] = { 0 };
+    utf8 buffer[128] = { 0 };
     utf8 * ch = buffer;
     ch = utf8_write_codepoint(ch, FORMAT_MEDIUMFONT);
     ch = utf8_write_codepoint(ch, FORMAT_OUTLINE);
     ch = utf8_write_codepoint(ch, FORMAT_WHITE);
 
-    snprintf(ch, 64 - (ch - buffer), "%d", _currentFPS);
+    if (de->GetFlags() & DEF_DIRTY_OPTIMISATIONS)
+    {
+        // Also show how much of the screen this frame repainted
+        DrawingEngineFrameStats stats = de->GetFrameStats();
+        snprintf(ch, sizeof(buffer) - (ch - buffer), "%d   %u/%u blocks in %u regions",
+            _currentFPS, stats.DirtyBlocks, stats.PaintedBlocks, stats.PaintedRegions);
+    }
+    else
+    {
+        snprintf(ch, sizeof(buffer) - (ch - buffer), "%d", _currentFPS);
+    }
 
     // Draw Text
     sint32 stringWidth = gfx_get_string_width(buffer);
@@ -49,7 +49,7 @@ namespace OpenRCT2
             void Paint(Drawing::IDrawingEngine * de);
 
         private:
-            void PaintFPS(rct_drawpixelinfo * dpi);
+            void PaintFPS(Drawing::IDrawingEngine * de, rct_drawpixelinfo * dpi);
             void MeasureFPS();
         };
     }
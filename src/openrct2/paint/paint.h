@@ -144,10 +144,38 @@ typedef struct tunnel_entry {
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT    65
 
+// Paint entries are allocated from chunks that are kept by the session for reuse
+#define PAINT_ENTRY_CHUNK_SIZE  512
+#define PAINT_ENTRY_MAX_CHUNKS  128
+
+typedef struct paint_entry_chunk paint_entry_chunk;
+struct paint_entry_chunk {
+    paint_entry         Entries[PAINT_ENTRY_CHUNK_SIZE];
+    paint_entry_chunk * Next;
+};
+
+typedef struct paint_arena_stats {
+    uint32 sessions;            // Sessions painted since the stats were reset
+    uint32 high_water_entries;  // Most entries used by a single session
+    uint32 chunks;              // Chunks owned by all sessions, including the first of each
+    uint32 dropped_entries;     // Entries not painted because a session hit PAINT_ENTRY_MAX_CHUNKS
+} paint_arena_stats;
+
+enum {
+    PAINT_PHASE_GENERATE,
+    PAINT_PHASE_ARRANGE,
+    PAINT_PHASE_DRAW,
+    PAINT_PHASE_COUNT
+};
+
 typedef struct paint_session
 {
     rct_drawpixelinfo *     Unk140E9A8;
-    paint_entry             PaintStructs[4000];
+    paint_entry_chunk       FirstPaintChunk;
+    paint_entry_chunk *     CurrentPaintChunk;
+    uint32                  PaintChunkCount;            // Chunks allocated after FirstPaintChunk
+    uint32                  PaintEntriesInFullChunks;
+    uint32                  DroppedPaintEntries;
     paint_struct *          Quadrants[MAX_PAINT_QUADRANTS];
     uint32                  QuadrantBackIndex;
     uint32                  QuadrantFrontIndex;
@@ -175,8 +203,12 @@ typedef struct paint_session
     uint8                   Unk141E9DB;
     uint16                  Unk141E9DC;
     uint32                  TrackColours[4];
+    rct_drawpixelinfo       DPI;
+    uint64                  PhaseTimes[PAINT_PHASE_COUNT];  // Microseconds, only measured when gPaintPhaseTimingEnabled
 } paint_session;
 
+typedef void (*paint_session_callback)(paint_session * session, uint32 viewFlags);
+
 extern paint_session gPaintSession;
 
 #ifndef NO_RCT2
@@ -213,6 +245,10 @@ extern const uint32 construction_markers[];
 extern bool gShowDirtyVisuals;
 extern bool gPaintBoundingBoxes;
 
+extern const char * const PaintPhaseNames[PAINT_PHASE_COUNT];
+// When set, sessions measure the time spent in each phase and add it to the totals when freed
+extern bool gPaintPhaseTimingEnabled;
+
 paint_struct * sub_98196C(paint_session * session, uint32 image_id, sint8 x_offset, sint8 y_offset, sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z, sint16 z_offset, uint32 rotation);
 paint_struct * sub_98197C(paint_session * session, uint32 image_id, sint8 x_offset, sint8 y_offset, sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z, sint16 z_offset, sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z, uint32 rotation);
 paint_struct * sub_98198C(paint_session * session, uint32 image_id, sint8 x_offset, sint8 y_offset, sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z, sint16 z_offset, sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z, uint32 rotation);
@@ -230,6 +266,14 @@ void paint_floating_money_effect(paint_session * session, money32 amount, rct_st
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi);
 void paint_session_free(paint_session *);
+uint32 paint_session_get_entry_count(const paint_session * session);
+void paint_get_arena_stats(paint_arena_stats * stats);
+void paint_reset_arena_stats();
+void paint_get_phase_times(uint64 times[PAINT_PHASE_COUNT]);
+void paint_reset_phase_times();
+bool paint_session_can_draw_async();
+void paint_session_draw_async(paint_session * session, uint32 viewFlags, paint_session_callback draw, paint_session_callback finish);
+void paint_session_wait_all();
 void paint_session_generate(paint_session * session);
 paint_struct paint_session_arrange(paint_session * session);
 paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag);
@@ -0,0 +1,480 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../core/JobPool.hpp"
+#include "../core/Math.hpp"
+#include "../ride/ride.h"
+#include "../util/util.h"
+#include "../world/footpath.h"
+#include "PathDistanceField.h"
+#include "Peep.h"
+
+constexpr uint16 DISTANCE_MAX = 0xFFFE;
+
+struct PathDistanceFieldKey
+{
+    sint16 X;
+    sint16 Y;
+    uint8  Z;
+    uint8  QueueRideIndex;
+    bool   IgnoreForeignQueues;
+
+    bool operator==(const PathDistanceFieldKey &other) const
+    {
+        return X == other.X && Y == other.Y && Z == other.Z && QueueRideIndex == other.QueueRideIndex &&
+               IgnoreForeignQueues == other.IgnoreForeignQueues;
+    }
+};
+
+struct PathDistanceField
+{
+    PathDistanceFieldKey Key;
+    // Steps to the goal from each path node, keyed by GetNodeKey
+    std::unordered_map<uint64, uint16> Distances;
+    // Bounds of every tile examined while building the field
+    sint32 Left;
+    sint32 Top;
+    sint32 Right;
+    sint32 Bottom;
+    uint32 LastUsed;
+};
+
+static std::vector<PathDistanceField *> _fields;
+static uint32 _useCounter;
+
+static bool _fieldsMissing = true;
+
+static std::vector<PathDistanceFieldKey> _requests;
+static std::unordered_set<uint64> _requestedKeys;
+static std::unique_ptr<JobPool> _jobPool;
+
+// Keys keep 16 bits for each tile coordinate so that they do not depend on the maximum map size
+static_assert(MAXIMUM_MAP_SIZE_TECHNICAL <= 0x10000, "Tile coordinates must fit in 16 bits");
+
+static uint64 GetNodeKey(sint32 x, sint32 y, sint32 z)
+{
+    return ((uint64)(uint16)x << 32) | ((uint64)(uint16)y << 16) | (uint8)z;
+}
+
+static uint64 GetRequestKey(const PathDistanceFieldKey &key)
+{
+    return ((uint64)(uint16)key.X << 48) | ((uint64)(uint16)key.Y << 32) | ((uint64)key.Z << 16) |
+           ((uint64)key.QueueRideIndex << 8) | (key.IgnoreForeignQueues ? 1 : 0);
+}
+
+static bool IsTileValid(sint32 x, sint32 y)
+{
+    return x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+static sint32 GetStepHeight(rct_map_element * pathElement, sint32 z, sint32 direction)
+{
+    if (footpath_element_is_sloped(pathElement) && footpath_element_get_slope_direction(pathElement) == direction)
+    {
+        return z + 2;
+    }
+    return z;
+}
+
+/**
+ * Whether a guest can walk through the path element, matching where peep_pathfind_heuristic_search
+ * continues a search path: wide paths and the queues of other rides end it.
+ */
+static bool IsTraversablePath(const PathDistanceFieldKey &key, rct_map_element * mapElement)
+{
+    if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_PATH)
+        return false;
+    if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST)
+        return false;
+    if (footpath_element_is_wide(mapElement))
+        return false;
+    if (key.IgnoreForeignQueues && footpath_element_is_queue(mapElement) &&
+        mapElement->properties.path.ride_index != key.QueueRideIndex && mapElement->properties.path.ride_index != 0xFF &&
+        bitcount(path_get_permitted_edges(mapElement)) == 2)
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Whether walking onto the goal tile at height z in the given direction reaches the goal, using the
+ * same element checks as peep_pathfind_heuristic_search.
+ */
+static bool IsGoalReached(const PathDistanceFieldKey &key, sint32 z, sint32 direction)
+{
+    rct_map_element * mapElement = map_get_first_element_at(key.X, key.Y);
+    do
+    {
+        if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST)
+            continue;
+
+        switch (map_element_get_type(mapElement))
+        {
+        case MAP_ELEMENT_TYPE_TRACK:
+            if (z == key.Z && mapElement->base_height == z &&
+                ride_type_has_flag(get_ride(mapElement->properties.track.ride_index)->type, RIDE_TYPE_FLAG_IS_SHOP))
+            {
+                return true;
+            }
+            break;
+        case MAP_ELEMENT_TYPE_ENTRANCE:
+            if (z != key.Z || mapElement->base_height != z)
+                break;
+            switch (mapElement->properties.entrance.type)
+            {
+            case ENTRANCE_TYPE_PARK_ENTRANCE:
+                return true;
+            case ENTRANCE_TYPE_RIDE_ENTRANCE:
+            case ENTRANCE_TYPE_RIDE_EXIT:
+                if (map_element_get_direction(mapElement) == direction)
+                    return true;
+                break;
+            }
+            break;
+        case MAP_ELEMENT_TYPE_PATH:
+            if (mapElement->base_height == key.Z && is_valid_path_z_and_direction(mapElement, z, direction))
+                return true;
+            break;
+        }
+    } while (!map_element_is_last_for_tile(mapElement++));
+    return false;
+}
+
+static bool HasTraversablePathTo(const PathDistanceFieldKey &key, sint32 x, sint32 y, sint32 z, sint32 stepHeight,
+                                 sint32 direction)
+{
+    rct_map_element * mapElement = map_get_first_element_at(x, y);
+    do
+    {
+        if (mapElement->base_height == z && IsTraversablePath(key, mapElement) &&
+            is_valid_path_z_and_direction(mapElement, stepHeight, direction))
+        {
+            return true;
+        }
+    } while (!map_element_is_last_for_tile(mapElement++));
+    return false;
+}
+
+static void IncludeTile(PathDistanceField * field, sint32 x, sint32 y)
+{
+    field->Left   = Math::Min(field->Left, x);
+    field->Top    = Math::Min(field->Top, y);
+    field->Right  = Math::Max(field->Right, x);
+    field->Bottom = Math::Max(field->Bottom, y);
+}
+
+/**
+ * Adds every path node that can step onto the tile x, y in the given direction and be accepted by
+ * the predicate, at the given distance.
+ */
+template<typename TPredicate>
+static void AddPredecessors(PathDistanceField * field, std::deque<uint64> &queue, sint32 x, sint32 y, sint32 direction,
+                            uint16 distance, TPredicate isReached)
+{
+    sint32 previousX = x - TileDirectionDelta[direction].x / 32;
+    sint32 previousY = y - TileDirectionDelta[direction].y / 32;
+    if (!IsTileValid(previousX, previousY))
+        return;
+
+    IncludeTile(field, previousX, previousY);
+    rct_map_element * mapElement = map_get_first_element_at(previousX, previousY);
+    do
+    {
+        if (!IsTraversablePath(field->Key, mapElement))
+            continue;
+        if (!(path_get_permitted_edges(mapElement) & (1 << direction)))
+            continue;
+
+        uint64 nodeKey = GetNodeKey(previousX, previousY, mapElement->base_height);
+        if (field->Distances.find(nodeKey) != field->Distances.end())
+            continue;
+
+        if (isReached(GetStepHeight(mapElement, mapElement->base_height, direction)))
+        {
+            field->Distances[nodeKey] = distance;
+            queue.push_back(nodeKey);
+        }
+    } while (!map_element_is_last_for_tile(mapElement++));
+}
+
+/**
+ * Builds the distance field with a breadth first search backwards from the goal along the
+ * footpath connections.
+ */
+static void BuildField(PathDistanceField * field)
+{
+    const PathDistanceFieldKey &key = field->Key;
+    field->Left   = field->Right  = key.X;
+    field->Top    = field->Bottom = key.Y;
+
+    std::deque<uint64> queue;
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        AddPredecessors(field, queue, key.X, key.Y, direction, 1, [&key, direction](sint32 stepHeight) -> bool
+        {
+            return IsGoalReached(key, stepHeight, direction);
+        });
+    }
+
+    while (!queue.empty())
+    {
+        uint64 nodeKey = queue.front();
+        queue.pop_front();
+
+        uint16 distance = field->Distances[nodeKey];
+        if (distance >= DISTANCE_MAX)
+            continue;
+
+        sint32 x = (nodeKey >> 32) & 0xFFFF;
+        sint32 y = (nodeKey >> 16) & 0xFFFF;
+        sint32 z = nodeKey & 0xFF;
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            AddPredecessors(field, queue, x, y, direction, distance + 1, [&key, x, y, z, direction](sint32 stepHeight) -> bool
+            {
+                return HasTraversablePathTo(key, x, y, z, stepHeight, direction);
+            });
+        }
+    }
+}
+
+static PathDistanceField * FindField(const PathDistanceFieldKey &key)
+{
+    for (PathDistanceField * field : _fields)
+    {
+        if (field->Key == key)
+        {
+            return field;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Adds a built field to the cache, replacing the least recently used field when the cache is full.
+ */
+static void AddField(PathDistanceField * field)
+{
+    field->LastUsed = ++_useCounter;
+    if (_fields.size() < PATH_DISTANCE_FIELD_MAX_FIELDS)
+    {
+        _fields.push_back(field);
+        return;
+    }
+
+    auto leastRecentlyUsed = _fields.begin();
+    for (auto it = _fields.begin(); it != _fields.end(); it++)
+    {
+        if ((*it)->LastUsed < (*leastRecentlyUsed)->LastUsed)
+        {
+            leastRecentlyUsed = it;
+        }
+    }
+    delete *leastRecentlyUsed;
+    *leastRecentlyUsed = field;
+}
+
+static PathDistanceField * GetField(const PathDistanceFieldKey &key)
+{
+    PathDistanceField * field = FindField(key);
+    if (field != nullptr)
+    {
+        field->LastUsed = ++_useCounter;
+        return field;
+    }
+
+    field = new PathDistanceField();
+    field->Key = key;
+    BuildField(field);
+    AddField(field);
+    _fieldsMissing = true;
+    return field;
+}
+
+extern "C"
+{
+    void path_distance_field_invalidate_all()
+    {
+        for (PathDistanceField * field : _fields)
+        {
+            delete field;
+        }
+        _fields.clear();
+        _fieldsMissing = true;
+    }
+
+    void path_distance_field_invalidate_tile(sint32 x, sint32 y)
+    {
+        path_distance_field_invalidate_area(x, y, x, y);
+    }
+
+    void path_distance_field_invalidate_area(sint32 left, sint32 top, sint32 right, sint32 bottom)
+    {
+        for (size_t i = 0; i < _fields.size();)
+        {
+            PathDistanceField * field = _fields[i];
+            if (field->Left <= right && field->Right >= left && field->Top <= bottom && field->Bottom >= top)
+            {
+                delete field;
+                _fields[i] = _fields.back();
+                _fields.pop_back();
+                _fieldsMissing = true;
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    void path_distance_field_request(sint32 x, sint32 y, sint32 z, uint8 queueRideIndex, bool ignoreForeignQueues)
+    {
+        if (!IsTileValid(x, y))
+            return;
+
+        PathDistanceFieldKey key;
+        key.X                   = x;
+        key.Y                   = y;
+        key.Z                   = (uint8)z;
+        key.QueueRideIndex      = queueRideIndex;
+        key.IgnoreForeignQueues = ignoreForeignQueues;
+        if (_requests.size() < PATH_DISTANCE_FIELD_MAX_FIELDS && _requestedKeys.insert(GetRequestKey(key)).second)
+        {
+            _requests.push_back(key);
+        }
+    }
+
+    void path_distance_field_build_requests()
+    {
+        std::vector<PathDistanceField *> newFields;
+        for (const PathDistanceFieldKey &key : _requests)
+        {
+            PathDistanceField * field = FindField(key);
+            if (field == nullptr)
+            {
+                field = new PathDistanceField();
+                field->Key = key;
+                newFields.push_back(field);
+            }
+            else
+            {
+                field->LastUsed = ++_useCounter;
+            }
+        }
+        _requests.clear();
+        _requestedKeys.clear();
+        _fieldsMissing = false;
+
+        // Fields only read the map, so they can be built concurrently
+        if (newFields.size() > 1)
+        {
+            if (_jobPool == nullptr)
+            {
+                _jobPool = std::make_unique<JobPool>();
+            }
+            for (PathDistanceField * field : newFields)
+            {
+                _jobPool->AddTask([field]() -> void
+                {
+                    BuildField(field);
+                });
+            }
+            _jobPool->Join();
+        }
+        else
+        {
+            for (PathDistanceField * field : newFields)
+            {
+                BuildField(field);
+            }
+        }
+
+        for (PathDistanceField * field : newFields)
+        {
+            AddField(field);
+        }
+    }
+
+    bool path_distance_field_is_missing()
+    {
+        return _fieldsMissing;
+    }
+
+    sint32 path_distance_field_choose_direction(sint32 x, sint32 y, sint32 z, rct_map_element * pathElement, uint8 edges)
+    {
+        if (footpath_element_is_wide(pathElement))
+        {
+            return -1;
+        }
+
+        PathDistanceFieldKey key;
+        key.X                   = gPeepPathFindGoalPosition.x >> 5;
+        key.Y                   = gPeepPathFindGoalPosition.y >> 5;
+        key.Z                   = (uint8)gPeepPathFindGoalPosition.z;
+        key.QueueRideIndex      = gPeepPathFindQueueRideIndex;
+        key.IgnoreForeignQueues = gPeepPathFindIgnoreForeignQueues;
+        if ((gPeepPathFindGoalPosition.x & 0x1F) || (gPeepPathFindGoalPosition.y & 0x1F) || !IsTileValid(key.X, key.Y))
+        {
+            return -1;
+        }
+
+        PathDistanceField * field = GetField(key);
+        if (field->Distances.empty())
+        {
+            return -1;
+        }
+
+        sint32 bestEdge     = -1;
+        uint32 bestDistance = UINT32_MAX;
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            if (!(edges & (1 << direction)))
+                continue;
+
+            sint32 nextX      = (x + TileDirectionDelta[direction].x) >> 5;
+            sint32 nextY      = (y + TileDirectionDelta[direction].y) >> 5;
+            sint32 stepHeight = GetStepHeight(pathElement, z, direction);
+            if (!IsTileValid(nextX, nextY))
+                continue;
+
+            if (nextX == key.X && nextY == key.Y && IsGoalReached(key, stepHeight, direction))
+            {
+                return direction;
+            }
+
+            rct_map_element * mapElement = map_get_first_element_at(nextX, nextY);
+            do
+            {
+                if (!IsTraversablePath(key, mapElement) || !is_valid_path_z_and_direction(mapElement, stepHeight, direction))
+                    continue;
+
+                auto it = field->Distances.find(GetNodeKey(nextX, nextY, mapElement->base_height));
+                if (it != field->Distances.end() && it->second < bestDistance)
+                {
+                    bestEdge     = direction;
+                    bestDistance = it->second;
+                }
+            } while (!map_element_is_last_for_tile(mapElement++));
+        }
+        return bestEdge;
+    }
+}
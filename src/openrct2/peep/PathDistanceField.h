@@ -0,0 +1,65 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _PATH_DISTANCE_FIELD_H_
+#define _PATH_DISTANCE_FIELD_H_
+
+#include "../common.h"
+#include "../world/map.h"
+
+// Maximum number of destinations that have a cached distance field at once
+#define PATH_DISTANCE_FIELD_MAX_FIELDS 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Distance fields cache, for each guest destination, the number of path steps from every
+ * connected footpath to the destination. They are built lazily the first time a guest heads for
+ * a destination and dropped when any tile that was examined while building them changes.
+ * All coordinates are in tiles.
+ */
+void path_distance_field_invalidate_all();
+void path_distance_field_invalidate_tile(sint32 x, sint32 y);
+void path_distance_field_invalidate_area(sint32 left, sint32 top, sint32 right, sint32 bottom);
+
+/**
+ * Queues a distance field to be built by the next call to path_distance_field_build_requests,
+ * which builds all queued fields that are not already cached on worker threads.
+ */
+void path_distance_field_request(sint32 x, sint32 y, sint32 z, uint8 queueRideIndex, bool ignoreForeignQueues);
+void path_distance_field_build_requests();
+
+/**
+ * Whether a field may need building, i.e. a field has been invalidated or built during the update
+ * since the last call to path_distance_field_build_requests.
+ */
+bool path_distance_field_is_missing();
+
+/**
+ * Chooses the edge of the path element at x, y, z (in pixels and height units) that leads to
+ * gPeepPathFindGoalPosition in the fewest steps, using the current pathfinding queue settings.
+ * @returns the chosen edge, or -1 if the distance field cannot answer and the heuristic search
+ *          should be used instead.
+ */
+sint32 path_distance_field_choose_direction(sint32 x, sint32 y, sint32 z, rct_map_element * pathElement, uint8 edges);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -40,10 +40,14 @@
 #include "../world/Climate.h"
 #include "../world/entrance.h"
 #include "../world/footpath.h"
+#include "../world/LitterSpatialIndex.h"
+#include "../world/ParkStatistics.h"
 #include "../world/map.h"
 #include "../world/scenery.h"
 #include "../world/sprite.h"
+#include "PathDistanceField.h"
 #include "Peep.h"
+#include "PeepSpatialIndex.h"
 #include "Staff.h"
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
@@ -542,6 +546,36 @@ sint32 peep_get_staff_count()
     return count;
 }
 
+/**
+ * Builds the distance fields for the destinations guests are walking to on worker threads before
+ * the guests are updated, so that the pathfinding in the serial guest update finds them cached.
+ * Only the field building is parallel, the guests themselves are still updated in sprite list order.
+ */
+static void peep_prepare_path_distance_fields()
+{
+    uint16     spriteIndex;
+    rct_peep * peep;
+
+    // Nothing to gather while every field the guests used last tick is still cached
+    if (!path_distance_field_is_missing())
+        return;
+
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->state != PEEP_STATE_WALKING || peep->outside_of_park != 0 || peep->pathfind_goal.x == 0xFF)
+            continue;
+
+        uint8 queueRideIndex = 255;
+        if (peep->guest_heading_to_ride_id != 0xFF && !(peep->peep_flags & PEEP_FLAGS_LEAVING_PARK))
+        {
+            queueRideIndex = peep->guest_heading_to_ride_id;
+        }
+        path_distance_field_request(peep->pathfind_goal.x, peep->pathfind_goal.y, peep->pathfind_goal.z, queueRideIndex,
+                                    true);
+    }
+    path_distance_field_build_requests();
+}
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -555,6 +589,11 @@ void peep_update_all()
     if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
         return;
 
+    if (gConfigGeneral.multithreaded_pathfinding)
+    {
+        peep_prepare_path_distance_fields();
+    }
+
     spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
     i           = 0;
     while (spriteIndex != SPRITE_INDEX_NULL)
@@ -575,6 +614,12 @@ void peep_update_all()
             }
         }
 
+        // Peeps that left the park during their update have already been removed from the statistics
+        if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2)
+        {
+            park_statistics_update_peep(peep);
+        }
+
         i++;
     }
 }
@@ -667,18 +712,8 @@ static uint8 peep_assess_surroundings(sint16 centre_x, sint16 centre_y, sint16 c
         }
     }
 
-    rct_litter * litter;
-    for (uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next)
-    {
-        litter = &(get_sprite(sprite_idx)->litter);
-
-        sint16 dist_x = abs(litter->x - centre_x);
-        sint16 dist_y = abs(litter->y - centre_y);
-        if (Math::Max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
-    }
+    // Litter counts are only compared against thresholds of 20 or less
+    num_rubbish += litter_spatial_index_count(centre_x - 160, centre_y - 160, centre_x + 160, centre_y + 160, nullptr, nullptr, 20);
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -6136,21 +6171,13 @@ static void peep_update_walking_break_scenery(rct_peep * peep)
         return;
     }
 
+    // Do not vandalise if there is a security guard within 7 tiles
+    peep_spatial_index_iterator it;
+    peep_spatial_index_iterator_begin(&it, PEEP_TYPE_STAFF, peep->x, peep->y, 223);
     rct_peep * inner_peep;
-    uint16     sprite_index;
-
-    FOR_ALL_STAFF(sprite_index, inner_peep)
+    while ((inner_peep = peep_spatial_index_iterator_next(&it)) != nullptr)
     {
-        if (inner_peep->staff_type != STAFF_TYPE_SECURITY)
-            continue;
-
-        if (inner_peep->x == LOCATION_NULL)
-            continue;
-
-        sint32 x_diff = abs(inner_peep->x - peep->x);
-        sint32 y_diff = abs(inner_peep->y - peep->y);
-
-        if (Math::Max(x_diff, y_diff) < 224)
+        if (inner_peep->staff_type == STAFF_TYPE_SECURITY)
             return;
     }
 
@@ -8066,6 +8093,7 @@ rct_peep * peep_generate(sint32 x, sint32 y, sint32 z)
     peep_update_name_sort(peep);
 
     increment_guests_heading_for_park();
+    park_statistics_update_peep(peep);
 
     return peep;
 }
@@ -8566,6 +8594,7 @@ void peep_insert_new_thought(rct_peep * peep, uint8 thought_type, uint8 thought_
     peep->thoughts[0].var_3 = 0;
 
     peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+    park_statistics_update_peep(peep);
 }
 
 /**
@@ -9533,7 +9562,7 @@ static sint32 banner_clear_path_edges(rct_map_element * mapElement, sint32 edges
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
-static sint32 path_get_permitted_edges(rct_map_element * mapElement)
+sint32 path_get_permitted_edges(rct_map_element * mapElement)
 {
     return banner_clear_path_edges(mapElement, mapElement->properties.path.edges) & 0x0F;
 }
@@ -10684,8 +10713,21 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * pe
 
     sint32 chosen_edge = bitscanforward(edges);
 
+    /* Guests heading for a destination walk along the shortest path when
+     * the destination has a distance field; the heuristic search below is
+     * used for staff and whenever the distance field has no answer. */
+    sint32 distance_field_edge = -1;
+    if ((edges & ~(1 << chosen_edge)) && peep->type == PEEP_TYPE_GUEST)
+    {
+        distance_field_edge = path_distance_field_choose_direction(x, y, z, first_map_element, edges);
+    }
+
+    if (distance_field_edge != -1)
+    {
+        chosen_edge = distance_field_edge;
+    }
     // Peep has multiple edges still to try.
-    if (edges & ~(1 << chosen_edge))
+    else if (edges & ~(1 << chosen_edge))
     {
         uint16 best_score = 0xFFFF;
         uint8  best_sub   = 0xFF;
@@ -14215,6 +14257,7 @@ void peep_handle_easteregg_name(rct_peep * peep)
     {
         peep->peep_flags |= PEEP_FLAGS_HERE_WE_ARE;
     }
+    park_statistics_update_peep(peep);
 }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
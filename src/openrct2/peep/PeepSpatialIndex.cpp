@@ -0,0 +1,354 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <vector>
+#include "../core/Math.hpp"
+#include "../world/sprite.h"
+#include "PeepSpatialIndex.h"
+
+constexpr sint32 BUCKETS_PER_AXIS = (MAXIMUM_MAP_SIZE_TECHNICAL * 32) >> PEEP_SPATIAL_INDEX_BUCKET_SHIFT;
+constexpr sint32 BUCKET_COUNT = BUCKETS_PER_AXIS * BUCKETS_PER_AXIS;
+constexpr uint16 BUCKET_NULL = 0xFFFF;
+constexpr uint8 PEEP_TYPE_NONE = 0xFF;
+
+// Guests and staff are kept in separate bucket lists so staff queries do not walk crowds of guests
+static uint16 _bucketHeads[2][BUCKET_COUNT];
+static uint16 _nextInBucket[MAX_SPRITES];
+static uint16 _previousInBucket[MAX_SPRITES];
+static uint16 _spriteBucket[MAX_SPRITES];
+static uint8 _spriteListType[MAX_SPRITES];
+static bool _indexValid;
+
+struct NearestPeepCandidate
+{
+    rct_peep * Peep;
+    sint32     Distance;
+    sint32     ListOrder;
+};
+
+static sint32 GetBucketCoordinate(sint32 value)
+{
+    return Math::Clamp(0, value >> PEEP_SPATIAL_INDEX_BUCKET_SHIFT, BUCKETS_PER_AXIS - 1);
+}
+
+static uint16 GetBucket(const rct_peep * peep)
+{
+    if (peep->x == LOCATION_NULL)
+    {
+        return BUCKET_NULL;
+    }
+    return (uint16)(GetBucketCoordinate(peep->x) * BUCKETS_PER_AXIS + GetBucketCoordinate(peep->y));
+}
+
+static bool IsIndexedType(uint8 peepType)
+{
+    return peepType == PEEP_TYPE_GUEST || peepType == PEEP_TYPE_STAFF;
+}
+
+static void RemoveFromBucket(uint16 spriteIndex)
+{
+    uint16 bucket = _spriteBucket[spriteIndex];
+    if (bucket == BUCKET_NULL)
+    {
+        return;
+    }
+
+    uint16 previous = _previousInBucket[spriteIndex];
+    uint16 next = _nextInBucket[spriteIndex];
+    if (previous == SPRITE_INDEX_NULL)
+    {
+        _bucketHeads[_spriteListType[spriteIndex]][bucket] = next;
+    }
+    else
+    {
+        _nextInBucket[previous] = next;
+    }
+    if (next != SPRITE_INDEX_NULL)
+    {
+        _previousInBucket[next] = previous;
+    }
+    _spriteBucket[spriteIndex] = BUCKET_NULL;
+    _spriteListType[spriteIndex] = PEEP_TYPE_NONE;
+}
+
+static void AddToBucket(uint16 spriteIndex, uint8 peepType, uint16 bucket)
+{
+    uint16 head = _bucketHeads[peepType][bucket];
+    _previousInBucket[spriteIndex] = SPRITE_INDEX_NULL;
+    _nextInBucket[spriteIndex] = head;
+    if (head != SPRITE_INDEX_NULL)
+    {
+        _previousInBucket[head] = spriteIndex;
+    }
+    _bucketHeads[peepType][bucket] = spriteIndex;
+    _spriteBucket[spriteIndex] = bucket;
+    _spriteListType[spriteIndex] = peepType;
+}
+
+static void RebuildIndex()
+{
+    std::fill_n(&_bucketHeads[0][0], 2 * BUCKET_COUNT, SPRITE_INDEX_NULL);
+    std::fill_n(_spriteBucket, MAX_SPRITES, BUCKET_NULL);
+    std::fill_n(_spriteListType, MAX_SPRITES, PEEP_TYPE_NONE);
+
+    for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP]; spriteIndex != SPRITE_INDEX_NULL;)
+    {
+        rct_peep * peep = GET_PEEP(spriteIndex);
+        uint16 bucket = GetBucket(peep);
+        if (bucket != BUCKET_NULL && IsIndexedType(peep->type))
+        {
+            AddToBucket(spriteIndex, peep->type, bucket);
+        }
+        spriteIndex = peep->next;
+    }
+    _indexValid = true;
+}
+
+static void EnsureIndexValid()
+{
+    if (!_indexValid)
+    {
+        RebuildIndex();
+    }
+}
+
+/**
+ * Orders candidates at an equal distance by their position in the peep sprite list.
+ * The list is only walked when a tie actually exists.
+ */
+static void ResolveTies(std::vector<NearestPeepCandidate> &candidates)
+{
+    bool hasTies = false;
+    for (size_t i = 1; i < candidates.size(); i++)
+    {
+        if (candidates[i].Distance == candidates[i - 1].Distance)
+        {
+            hasTies = true;
+            break;
+        }
+    }
+    if (!hasTies)
+    {
+        return;
+    }
+
+    size_t remaining = candidates.size();
+    sint32 listOrder = 0;
+    for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP]; spriteIndex != SPRITE_INDEX_NULL && remaining > 0;)
+    {
+        rct_peep * peep = GET_PEEP(spriteIndex);
+        for (auto &candidate : candidates)
+        {
+            if (candidate.Peep == peep)
+            {
+                candidate.ListOrder = listOrder;
+                remaining--;
+                break;
+            }
+        }
+        listOrder++;
+        spriteIndex = peep->next;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const NearestPeepCandidate &a, const NearestPeepCandidate &b) -> bool
+    {
+        if (a.Distance != b.Distance)
+        {
+            return a.Distance < b.Distance;
+        }
+        return a.ListOrder < b.ListOrder;
+    });
+}
+
+extern "C"
+{
+    void peep_spatial_index_invalidate()
+    {
+        _indexValid = false;
+    }
+
+    /**
+     * Called by sprite_move whenever a peep changes position.
+     */
+    void peep_spatial_index_update(rct_peep * peep)
+    {
+        if (!_indexValid)
+        {
+            return;
+        }
+
+        uint16 spriteIndex = peep->sprite_index;
+        uint16 bucket = IsIndexedType(peep->type) ? GetBucket(peep) : BUCKET_NULL;
+        if (bucket == _spriteBucket[spriteIndex] && peep->type == _spriteListType[spriteIndex])
+        {
+            return;
+        }
+
+        RemoveFromBucket(spriteIndex);
+        if (bucket != BUCKET_NULL)
+        {
+            AddToBucket(spriteIndex, peep->type, bucket);
+        }
+    }
+
+    void peep_spatial_index_remove(rct_peep * peep)
+    {
+        if (_indexValid)
+        {
+            RemoveFromBucket(peep->sprite_index);
+        }
+    }
+
+    void peep_spatial_index_iterator_begin(peep_spatial_index_iterator * it, uint8 peepType, sint32 x, sint32 y, sint32 radius)
+    {
+        EnsureIndexValid();
+
+        it->peep_type = peepType;
+        it->left = x - radius;
+        it->top = y - radius;
+        it->right = x + radius;
+        it->bottom = y + radius;
+        it->bucket_left = GetBucketCoordinate(it->left);
+        it->bucket_right = GetBucketCoordinate(it->right);
+        it->bucket_bottom = GetBucketCoordinate(it->bottom);
+        it->bucket_x = it->bucket_left;
+        it->bucket_y = GetBucketCoordinate(it->top);
+        it->next_sprite_index = SPRITE_INDEX_NULL;
+        if (IsIndexedType(peepType))
+        {
+            it->next_sprite_index = _bucketHeads[peepType][it->bucket_x * BUCKETS_PER_AXIS + it->bucket_y];
+        }
+        else
+        {
+            it->bucket_y = it->bucket_bottom + 1;
+            it->bucket_x = it->bucket_right + 1;
+        }
+    }
+
+    rct_peep * peep_spatial_index_iterator_next(peep_spatial_index_iterator * it)
+    {
+        while (it->bucket_x <= it->bucket_right)
+        {
+            while (it->next_sprite_index != SPRITE_INDEX_NULL)
+            {
+                rct_peep * peep = GET_PEEP(it->next_sprite_index);
+                it->next_sprite_index = _nextInBucket[it->next_sprite_index];
+                if (peep->x >= it->left && peep->x <= it->right &&
+                    peep->y >= it->top && peep->y <= it->bottom)
+                {
+                    return peep;
+                }
+            }
+
+            it->bucket_y++;
+            if (it->bucket_y > it->bucket_bottom)
+            {
+                it->bucket_y = GetBucketCoordinate(it->top);
+                it->bucket_x++;
+                if (it->bucket_x > it->bucket_right)
+                {
+                    break;
+                }
+            }
+            it->next_sprite_index = _bucketHeads[it->peep_type][it->bucket_x * BUCKETS_PER_AXIS + it->bucket_y];
+        }
+        return nullptr;
+    }
+
+    sint32 peep_spatial_index_find_nearest(uint8 peepType, sint32 x, sint32 y, peep_spatial_index_filter filter, const void * context, rct_peep * * results, sint32 maxResults)
+    {
+        if (maxResults <= 0 || !IsIndexedType(peepType))
+        {
+            return 0;
+        }
+        EnsureIndexValid();
+
+        // The early exit distance bound only holds when the point lies within the grid
+        constexpr sint32 gridSize = BUCKETS_PER_AXIS * PEEP_SPATIAL_INDEX_BUCKET_SIZE;
+        bool canExitEarly = x >= 0 && x < gridSize && y >= 0 && y < gridSize;
+
+        std::vector<NearestPeepCandidate> candidates;
+        sint32 centreX = GetBucketCoordinate(x);
+        sint32 centreY = GetBucketCoordinate(y);
+        for (sint32 ring = 0; ring < BUCKETS_PER_AXIS; ring++)
+        {
+            // Search the square ring of buckets at this distance from the centre bucket
+            for (sint32 bx = centreX - ring; bx <= centreX + ring; bx++)
+            {
+                if (bx < 0 || bx >= BUCKETS_PER_AXIS)
+                {
+                    continue;
+                }
+                bool edgeColumn = (bx == centreX - ring || bx == centreX + ring);
+                sint32 step = edgeColumn ? 1 : ring * 2;
+                for (sint32 by = centreY - ring; by <= centreY + ring; by += step)
+                {
+                    if (by < 0 || by >= BUCKETS_PER_AXIS)
+                    {
+                        continue;
+                    }
+                    uint16 spriteIndex = _bucketHeads[peepType][bx * BUCKETS_PER_AXIS + by];
+                    while (spriteIndex != SPRITE_INDEX_NULL)
+                    {
+                        rct_peep * peep = GET_PEEP(spriteIndex);
+                        if (filter == nullptr || filter(peep, context))
+                        {
+                            sint32 distance = abs(peep->x - x) + abs(peep->y - y);
+                            candidates.push_back({ peep, distance, 0 });
+                        }
+                        spriteIndex = _nextInBucket[spriteIndex];
+                    }
+                }
+            }
+
+            // Any peep in a further ring is more than ring * BUCKET_SIZE away
+            if (canExitEarly && (sint32)candidates.size() >= maxResults)
+            {
+                std::sort(candidates.begin(), candidates.end(), [](const NearestPeepCandidate &a, const NearestPeepCandidate &b) -> bool
+                {
+                    return a.Distance < b.Distance;
+                });
+                sint32 furthestDistance = candidates[maxResults - 1].Distance;
+                if (furthestDistance <= ring * PEEP_SPATIAL_INDEX_BUCKET_SIZE)
+                {
+                    break;
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const NearestPeepCandidate &a, const NearestPeepCandidate &b) -> bool
+        {
+            return a.Distance < b.Distance;
+        });
+
+        // Keep every candidate tied with the last result so ties are resolved correctly
+        size_t keep = Math::Min(candidates.size(), (size_t)maxResults);
+        while (keep > 0 && keep < candidates.size() && candidates[keep].Distance == candidates[keep - 1].Distance)
+        {
+            keep++;
+        }
+        candidates.resize(keep);
+        ResolveTies(candidates);
+
+        sint32 count = Math::Min((sint32)candidates.size(), maxResults);
+        for (sint32 i = 0; i < count; i++)
+        {
+            results[i] = candidates[i].Peep;
+        }
+        return count;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _PEEP_SPATIAL_INDEX_H_
+#define _PEEP_SPATIAL_INDEX_H_
+
+#include "../common.h"
+#include "Peep.h"
+
+// Each bucket covers an 8x8 tile area
+#define PEEP_SPATIAL_INDEX_BUCKET_SHIFT 8
+#define PEEP_SPATIAL_INDEX_BUCKET_SIZE  (1 << PEEP_SPATIAL_INDEX_BUCKET_SHIFT)
+
+typedef bool (*peep_spatial_index_filter)(const rct_peep * peep, const void * context);
+
+/**
+ * Iterates all guests or staff within a square around a point. Peeps are returned in
+ * bucket order rather than sprite list order, so callers must not depend on the order.
+ * Peeps must not be moved while an iterator is active.
+ */
+typedef struct peep_spatial_index_iterator {
+    uint8 peep_type;
+    sint32 left;
+    sint32 top;
+    sint32 right;
+    sint32 bottom;
+    sint32 bucket_x;
+    sint32 bucket_y;
+    sint32 bucket_left;
+    sint32 bucket_right;
+    sint32 bucket_bottom;
+    uint16 next_sprite_index;
+} peep_spatial_index_iterator;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void peep_spatial_index_invalidate();
+void peep_spatial_index_update(rct_peep * peep);
+void peep_spatial_index_remove(rct_peep * peep);
+
+void peep_spatial_index_iterator_begin(peep_spatial_index_iterator * it, uint8 peepType, sint32 x, sint32 y, sint32 radius);
+rct_peep * peep_spatial_index_iterator_next(peep_spatial_index_iterator * it);
+
+/**
+ * Finds up to maxResults guests or staff accepted by the filter, ordered by Manhattan distance to
+ * the given point. Peeps at an equal distance are ordered as they appear in the peep sprite list,
+ * which matches the result of a linear FOR_ALL_PEEPS search.
+ * @returns the number of peeps written to results.
+ */
+sint32 peep_spatial_index_find_nearest(uint8 peepType, sint32 x, sint32 y, peep_spatial_index_filter filter, const void * context, rct_peep * * results, sint32 maxResults);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -32,9 +32,12 @@
 #include "../util/util.h"
 #include "../world/entrance.h"
 #include "../world/footpath.h"
+#include "../world/LitterSpatialIndex.h"
+#include "../world/ParkStatistics.h"
 #include "../world/scenery.h"
 #include "../world/sprite.h"
 #include "Peep.h"
+#include "PeepSpatialIndex.h"
 #include "Staff.h"
 
 // clang-format off
@@ -314,6 +317,7 @@ static money32 staff_hire_new_staff_member(uint8 staff_type, uint8 flags, sint16
 
             newPeep->id         = newStaffIndex;
             newPeep->staff_type = staff_type;
+            park_statistics_update_peep(newPeep);
 
             static const rct_string_id staffNames[] = {
                 STR_HANDYMAN_X,
@@ -903,24 +907,8 @@ void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
  */
 static uint8 staff_handyman_direction_to_nearest_litter(rct_peep * peep)
 {
-    uint16       nearestLitterDist = (uint16)-1;
-    rct_litter * nearestLitter     = NULL;
-    rct_litter * litter            = NULL;
-
-    for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16 distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter     = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    rct_litter * nearestLitter = litter_spatial_index_find_nearest(peep->x, peep->y, peep->z, 0x60);
+    if (nearestLitter == NULL)
     {
         return 0xFF;
     }
@@ -1513,27 +1501,15 @@ static sint32 staff_path_finding_misc(rct_peep * peep)
  */
 static void staff_entertainer_update_nearby_peeps(rct_peep * peep)
 {
-    uint16     spriteIndex;
+    peep_spatial_index_iterator it;
+    peep_spatial_index_iterator_begin(&it, PEEP_TYPE_GUEST, peep->x, peep->y, 96);
     rct_peep * guest;
-
-    FOR_ALL_GUESTS(spriteIndex, guest)
+    while ((guest = peep_spatial_index_iterator_next(&it)) != nullptr)
     {
-        if (guest->x == LOCATION_NULL)
-            continue;
-
         sint16 z_dist = abs(peep->z - guest->z);
         if (z_dist > 48)
             continue;
 
-        sint16 x_dist = abs(peep->x - guest->x);
-        sint16 y_dist = abs(peep->y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
-
         if (peep->state == PEEP_STATE_WALKING)
         {
             peep->happiness_target = Math::Min(peep->happiness_target + 4, PEEP_MAX_HAPPINESS);
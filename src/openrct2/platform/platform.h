@@ -119,6 +119,8 @@ bool platform_file_copy(const utf8 *srcPath, const utf8 *dstPath, bool overwrite
 bool platform_file_move(const utf8 *srcPath, const utf8 *dstPath);
 bool platform_file_delete(const utf8 *path);
 uint32 platform_get_ticks();
+// Monotonic timestamp in microseconds, for measuring short durations
+uint64 platform_get_ticks_precise();
 void platform_sleep(uint32 ms);
 void platform_resolve_user_data_path();
 void platform_resolve_openrct_data_path();
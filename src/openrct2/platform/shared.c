@@ -51,6 +51,7 @@
 
 #ifdef _WIN32 
 static uint32 _frequency = 0;
+static LARGE_INTEGER _frequencyPrecise;
 static LARGE_INTEGER _entryTimestamp;
 #endif
 
@@ -149,6 +150,7 @@ static void platform_ticks_init()
     LARGE_INTEGER freq;
     QueryPerformanceFrequency(&freq);
     _frequency = (uint32)(freq.QuadPart / 1000);
+    _frequencyPrecise = freq;
     QueryPerformanceCounter(&_entryTimestamp);
 #endif
 }
@@ -175,6 +177,29 @@ uint32 platform_get_ticks()
 #endif
 }
 
+uint64 platform_get_ticks_precise()
+{
+#ifdef _WIN32
+    LARGE_INTEGER pfc;
+    QueryPerformanceCounter(&pfc);
+
+    LARGE_INTEGER runningDelta;
+    runningDelta.QuadPart = pfc.QuadPart - _entryTimestamp.QuadPart;
+
+    return (uint64)((runningDelta.QuadPart / _frequencyPrecise.QuadPart) * 1000000 +
+                    ((runningDelta.QuadPart % _frequencyPrecise.QuadPart) * 1000000) / _frequencyPrecise.QuadPart);
+#elif defined(__APPLE__) && (__ENVIRONMENT_MAC_OS_X_VERSION_MIN_REQUIRED__ < 101200)
+    return (uint64)((mach_absolute_time() * _mach_base_info.numer) / _mach_base_info.denom) / 1000;
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        log_fatal("clock_gettime failed");
+        exit(-1);
+    }
+    return (uint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
 void platform_sleep(uint32 ms)
 {
 #ifdef _WIN32
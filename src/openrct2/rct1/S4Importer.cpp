@@ -28,6 +28,7 @@
 #include "../core/Util.hpp"
 #include "../object/Object.h"
 #include "../object/ObjectManager.h"
+#include "../peep/PathDistanceField.h"
 #include "../object/ObjectRepository.h"
 #include "../ParkImporter.h"
 #include "../ride/station.h"
@@ -57,6 +58,7 @@
 #include "../world/footpath.h"
 #include "../world/map_animation.h"
 #include "../world/park.h"
+#include "../world/ParkStatistics.h"
 #include "../world/entrance.h"
 #include "../world/scenery.h"
 
@@ -1061,6 +1063,7 @@ private:
         ImportPeeps();
         ImportLitter();
         ImportMiscSprites();
+        park_statistics_invalidate();
     }
 
     void ImportVehicles()
@@ -1873,6 +1876,7 @@ private:
     void ImportMapElements()
     {
         Memory::Copy(gMapElements, _s4.map_elements, RCT1_MAX_MAP_ELEMENTS * sizeof(rct_map_element));
+        path_distance_field_invalidate_all();
         ClearExtraTileEntries();
         FixSceneryColours();
         FixMapElementZ();
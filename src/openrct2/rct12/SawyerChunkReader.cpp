@@ -102,21 +102,59 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
 
 void SawyerChunkReader::ReadChunk(void * dst, size_t length)
 {
-    auto chunk = ReadChunk();
-    const void * chunkData = chunk->GetData();
-    size_t chunkLength = chunk->GetLength();
-    if (chunkLength > length)
-    {
-        Memory::Copy(dst, chunkData, length);
-    }
-    else
+    DecodeChunk(dst, length, ReadEncodedChunk());
+}
+
+std::vector<uint8> SawyerChunkReader::ReadEncodedChunk()
+{
+    uint64 originalPosition = _stream->GetPosition();
+    try
     {
-        Memory::Copy(dst, chunkData, chunkLength);
-        size_t remainingLength = length - chunkLength;
-        if (remainingLength > 0)
+        auto header = _stream->ReadValue<sawyercoding_chunk_header>();
+        switch (header.encoding) {
+        case CHUNK_ENCODING_NONE:
+        case CHUNK_ENCODING_RLE:
+        case CHUNK_ENCODING_RLECOMPRESSED:
+        case CHUNK_ENCODING_ROTATE:
         {
-            void * offset = (void *)((uintptr_t)dst + chunkLength);
-            Memory::Set(offset, 0, remainingLength);
+            std::vector<uint8> encodedChunk(sizeof(sawyercoding_chunk_header) + header.length);
+            Memory::Copy<void>(encodedChunk.data(), &header, sizeof(sawyercoding_chunk_header));
+            uint8 * compressedData = encodedChunk.data() + sizeof(sawyercoding_chunk_header);
+            if (_stream->TryRead(compressedData, header.length) != header.length)
+            {
+                throw SawyerChunkException("Corrupt chunk size.");
+            }
+            return encodedChunk;
         }
+        default:
+            throw SawyerChunkException("Invalid chunk encoding.");
+        }
+    }
+    catch (Exception)
+    {
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+}
+
+void SawyerChunkReader::DecodeChunk(void * dst, size_t length, const std::vector<uint8> &encodedChunk)
+{
+    Guard::Assert(encodedChunk.size() >= sizeof(sawyercoding_chunk_header), "Invalid encoded chunk");
+    sawyercoding_chunk_header header;
+    Memory::Copy<void>(&header, encodedChunk.data(), sizeof(sawyercoding_chunk_header));
+
+    // Decode straight into the destination, anything beyond length is discarded
+    size_t chunkLength = 0;
+    if (length > 0 && header.length > 0)
+    {
+        const uint8 * compressedData = encodedChunk.data() + sizeof(sawyercoding_chunk_header);
+        chunkLength = sawyercoding_read_chunk_buffer((uint8 *)dst, compressedData, header, length);
+    }
+    size_t remainingLength = length - chunkLength;
+    if (remainingLength > 0)
+    {
+        void * offset = (void *)((uintptr_t)dst + chunkLength);
+        Memory::Set(offset, 0, remainingLength);
     }
 }
@@ -19,6 +19,7 @@
 #ifdef __cplusplus
 
 #include <memory>
+#include <vector>
 #include "../common.h"
 #include "SawyerChunk.h"
 
@@ -57,6 +58,21 @@ public:
      */
     void ReadChunk(void * dst, size_t length);
 
+    /**
+     * Reads the next chunk from the stream without decoding it. The chunk
+     * can be decoded later with DecodeChunk, e.g. once the destination is
+     * ready to be overwritten.
+     * @returns the chunk header followed by the encoded data.
+     */
+    std::vector<uint8> ReadEncodedChunk();
+
+    /**
+     * Decodes a chunk returned by ReadEncodedChunk directly to the
+     * destination buffer, with the same truncation and zero padding as
+     * ReadChunk(void *, size_t).
+     */
+    static void DecodeChunk(void * dst, size_t length, const std::vector<uint8> &encodedChunk);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
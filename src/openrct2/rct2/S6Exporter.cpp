@@ -25,10 +25,15 @@
 #include "../object/ObjectRepository.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "S6Exporter.h"
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <thread>
 
 #include "../config/Config.h"
+#include "../Context.h"
 #include "../game.h"
+#include "../interface/console.h"
 #include "../interface/viewport.h"
 #include "../interface/window.h"
 #include "../localisation/date.h"
@@ -40,6 +45,7 @@
 #include "../object.h"
 #include "../OpenRCT2.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
 #include "../ride/ride.h"
 #include "../ride/ride_ratings.h"
 #include "../ride/track_data.h"
@@ -183,7 +189,9 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.map_elements, gMapElements, sizeof(_s6.map_elements));
+    // Elements are written tile by tile as the store may be fragmented or larger than the saved game
+    uint32 numMapElements = map_copy_elements_in_tile_order(_s6.map_elements, RCT2_MAX_MAP_ELEMENTS);
+    memset(_s6.map_elements + numMapElements, 0, (RCT2_MAX_MAP_ELEMENTS - numMapElements) * sizeof(rct_map_element));
 
     _s6.next_free_map_element_pointer_index = gNextFreeMapElementPointerIndex;
     // Sprites needs to be reset before they get used.
@@ -652,37 +660,89 @@ void S6Exporter::ExportRide(rct2_ride * dst, const Ride * src)
     // pad_208[0x58];
 }
 
-extern "C"
+enum {
+    S6_SAVE_FLAG_EXPORT    = 1 << 0,
+    S6_SAVE_FLAG_SCENARIO  = 1 << 1,
+    S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
+};
+
+struct BackgroundSave
+{
+    std::thread         Thread;
+    std::string         Path;
+    sint32              Flags = 0;
+    bool                Active = false;
+    bool                Result = false;
+    std::atomic<bool>   Finished { false };
+};
+
+// Only one save is written in the background at a time, it is only touched by the game thread apart from Result and Finished
+static BackgroundSave _backgroundSave;
+
+static void scenario_save_begin(sint32 flags)
 {
-    enum {
-        S6_SAVE_FLAG_EXPORT    = 1 << 0,
-        S6_SAVE_FLAG_SCENARIO  = 1 << 1,
-        S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
-    };
+    if (flags & S6_SAVE_FLAG_SCENARIO)
+    {
+        log_verbose("saving scenario");
+    }
+    else
+    {
+        log_verbose("saving game");
+    }
 
-    /**
-     *
-     *  rct2: 0x006754F5
-     * @param flags bit 0: pack objects, 1: save as scenario
-     */
-    sint32 scenario_save(const utf8 * path, sint32 flags)
+    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        window_close_construction_windows();
+    }
+
+    map_reorganise_elements();
+    viewport_set_saved_view();
+}
+
+/**
+ * Encodes and writes an exported park on the background save thread. The file is written under a temporary name and
+ * renamed once complete, so an interrupted save never leaves a truncated park behind.
+ */
+static void scenario_save_write_background(S6Exporter * s6exporter, std::string path, sint32 flags)
+{
+    std::string tempPath = path + ".tmp";
+    bool result = false;
+    try
     {
         if (flags & S6_SAVE_FLAG_SCENARIO)
         {
-            log_verbose("saving scenario");
+            s6exporter->SaveScenario(tempPath.c_str());
         }
         else
         {
-            log_verbose("saving game");
+            s6exporter->SaveGame(tempPath.c_str());
         }
+        result = platform_file_move(tempPath.c_str(), path.c_str());
+    }
+    catch (const std::exception &ex)
+    {
+        log_error("Unable to write '%s': %s", path.c_str(), ex.what());
+    }
+    delete s6exporter;
 
-        if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
-        {
-            window_close_construction_windows();
-        }
+    if (!result)
+    {
+        platform_file_delete(tempPath.c_str());
+    }
+    _backgroundSave.Result = result;
+    _backgroundSave.Finished = true;
+}
 
-        map_reorganise_elements();
-        viewport_set_saved_view();
+extern "C"
+{
+    /**
+     *
+     *  rct2: 0x006754F5
+     * @param flags bit 0: pack objects, 1: save as scenario
+     */
+    sint32 scenario_save(const utf8 * path, sint32 flags)
+    {
+        scenario_save_begin(flags);
 
         bool result     = false;
         auto s6exporter = new S6Exporter();
@@ -718,4 +778,88 @@ extern "C"
         }
         return result;
     }
+
+    /**
+     * Takes a snapshot of the park on the calling thread and leaves encoding, checksumming and writing the file to a
+     * background thread. Waits for a save that is still being written first. Saves that pack objects read the object
+     * repository while writing, so those are saved synchronously.
+     * @returns false if the park could not be exported.
+     */
+    bool scenario_save_in_background(const utf8 * path, sint32 flags)
+    {
+        if (flags & S6_SAVE_FLAG_EXPORT)
+        {
+            return scenario_save(path, flags) != 0;
+        }
+
+        scenario_save_wait_for_background();
+        scenario_save_update_background();
+        scenario_save_begin(flags);
+
+        auto s6exporter = std::make_unique<S6Exporter>();
+        try
+        {
+            s6exporter->RemoveTracklessRides = true;
+            s6exporter->Export();
+        }
+        catch (const Exception &)
+        {
+            gfx_invalidate_screen();
+            return false;
+        }
+        gfx_invalidate_screen();
+
+        _backgroundSave.Path = path;
+        _backgroundSave.Flags = flags;
+        _backgroundSave.Active = true;
+        _backgroundSave.Result = false;
+        _backgroundSave.Finished = false;
+        _backgroundSave.Thread = std::thread(scenario_save_write_background, s6exporter.release(), std::string(path), flags);
+        return true;
+    }
+
+    bool scenario_save_is_in_background()
+    {
+        return _backgroundSave.Active;
+    }
+
+    /**
+     * Reports a background save that has finished. Must be called regularly from the game thread.
+     */
+    void scenario_save_update_background()
+    {
+        if (!_backgroundSave.Active || !_backgroundSave.Finished)
+        {
+            return;
+        }
+
+        scenario_save_wait_for_background();
+        _backgroundSave.Active = false;
+        if (_backgroundSave.Result)
+        {
+            log_verbose("saved '%s'", _backgroundSave.Path.c_str());
+            console_printf("Saved %s", _backgroundSave.Path.c_str());
+            if (!(_backgroundSave.Flags & S6_SAVE_FLAG_AUTOMATIC))
+            {
+                gScreenAge = 0;
+            }
+        }
+        else
+        {
+            log_error("Failed to save '%s'", _backgroundSave.Path.c_str());
+            console_writeline_error("Failed to save the park in the background.");
+            context_show_error((_backgroundSave.Flags & S6_SAVE_FLAG_SCENARIO) ? STR_SCENARIO_SAVE_FAILED : STR_GAME_SAVE_FAILED, STR_NONE);
+        }
+    }
+
+    /**
+     * Blocks until a background save has been written, the result is reported by the next update.
+     */
+    void scenario_save_wait_for_background()
+    {
+        if (_backgroundSave.Thread.joinable())
+        {
+            _backgroundSave.Thread.join();
+        }
+    }
 }
@@ -40,12 +40,15 @@
 #include "../management/NewsItem.h"
 #include "../management/Research.h"
 #include "../OpenRCT2.h"
+#include "../peep/PeepSpatialIndex.h"
 #include "../peep/Staff.h"
 #include "../ride/ride.h"
 #include "../ride/ride_ratings.h"
 #include "../scenario/scenario.h"
 #include "../util/sawyercoding.h"
 #include "../world/Climate.h"
+#include "../world/LitterSpatialIndex.h"
+#include "../world/ParkStatistics.h"
 #include "../world/entrance.h"
 #include "../world/map_animation.h"
 #include "../world/park.h"
@@ -70,6 +73,9 @@ private:
     rct_s6_data     _s6;
     uint8           _gameVersion = 0;
 
+    // Decoded straight into gMapElements on import, rather than staged in _s6.map_elements
+    std::vector<uint8> _mapElementsChunk;
+
 public:
     S6Importer(IObjectRepository * objectRepository, IObjectManager * objectManager)
         : _objectRepository(objectRepository),
@@ -152,7 +158,7 @@ public:
         {
             chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
             chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.map_elements, sizeof(_s6.map_elements));
+            _mapElementsChunk = chunkReader.ReadEncodedChunk();
             chunkReader.ReadChunk(&_s6.next_free_map_element_pointer_index, 2560076);
             chunkReader.ReadChunk(&_s6.guests_in_park, 4);
             chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
@@ -166,7 +172,7 @@ public:
         {
             chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
             chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.map_elements, sizeof(_s6.map_elements));
+            _mapElementsChunk = chunkReader.ReadEncodedChunk();
             chunkReader.ReadChunk(&_s6.next_free_map_element_pointer_index, 3048816);
         }
 
@@ -198,19 +204,24 @@ public:
         gScenarioSrand0    = _s6.scenario_srand_0;
         gScenarioSrand1    = _s6.scenario_srand_1;
 
-        memcpy(gMapElements, _s6.map_elements, sizeof(_s6.map_elements));
+        SawyerChunkReader::DecodeChunk(gMapElements, sizeof(_s6.map_elements), _mapElementsChunk);
+        _mapElementsChunk.clear();
+        _mapElementsChunk.shrink_to_fit();
 
         gNextFreeMapElementPointerIndex = _s6.next_free_map_element_pointer_index;
-        for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
-        {
-            memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
-        }
+        // The sprites are staged in _s6 as the map size, which is needed to initialise the park, is stored after them.
+        // The sprite list is one contiguous block with the same layout, so copy it all at once.
+        static_assert(RCT2_MAX_SPRITES <= MAX_SPRITES, "Sprite list is too small for RCT2 sprites");
+        memcpy(get_sprite(0), _s6.sprites, sizeof(_s6.sprites));
 
         for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
         {
             gSpriteListHead[i]  = _s6.sprite_lists_head[i];
             gSpriteListCount[i] = _s6.sprite_lists_count[i];
         }
+        peep_spatial_index_invalidate();
+        litter_spatial_index_invalidate();
+        park_statistics_invalidate();
         gParkName = _s6.park_name;
         // pad_013573D6
         gParkNameArgs    = _s6.park_name_args;
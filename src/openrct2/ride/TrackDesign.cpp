@@ -42,7 +42,9 @@
 
 typedef struct map_backup
 {
-    rct_map_element map_elements[MAX_MAP_ELEMENTS];
+    rct_map_element * map_elements;
+    rct_map_element * map_elements_base;
+    uint32          map_elements_capacity;
     rct_map_element * tile_pointers[MAX_TILE_MAP_ELEMENT_POINTERS];
     rct_map_element * next_free_map_element;
     uint16          map_size_units;
@@ -2284,11 +2286,19 @@ static map_backup * track_design_preview_backup_map()
     map_backup * backup = (map_backup *) malloc(sizeof(map_backup));
     if (backup != NULL)
     {
+        backup->map_elements = (rct_map_element *) malloc(gMapElementsCapacity * sizeof(rct_map_element));
+        if (backup->map_elements == NULL)
+        {
+            free(backup);
+            return NULL;
+        }
         memcpy(
             backup->map_elements,
             gMapElements,
-            sizeof(backup->map_elements)
+            gMapElementsCapacity * sizeof(rct_map_element)
         );
+        backup->map_elements_base     = gMapElements;
+        backup->map_elements_capacity = gMapElementsCapacity;
         memcpy(
             backup->tile_pointers,
             gMapElementTilePointers,
@@ -2309,22 +2319,31 @@ static map_backup * track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup * backup)
 {
+    // The preview may have grown the element store, so match the backed up capacity and rebase the pointers
+    if (gMapElementsCapacity != backup->map_elements_capacity)
+    {
+        gNextFreeMapElement = gMapElements;
+        map_resize_elements(backup->map_elements_capacity);
+    }
     memcpy(
         gMapElements,
         backup->map_elements,
-        sizeof(backup->map_elements)
+        backup->map_elements_capacity * sizeof(rct_map_element)
     );
-    memcpy(
-        gMapElementTilePointers,
-        backup->tile_pointers,
-        sizeof(backup->tile_pointers)
-    );
-    gNextFreeMapElement = backup->next_free_map_element;
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++)
+    {
+        rct_map_element * mapElement = backup->tile_pointers[i];
+        gMapElementTilePointers[i] = (mapElement == TILE_UNDEFINED_MAP_ELEMENT) ?
+            TILE_UNDEFINED_MAP_ELEMENT :
+            gMapElements + (mapElement - backup->map_elements_base);
+    }
+    gNextFreeMapElement = gMapElements + (backup->next_free_map_element - backup->map_elements_base);
     gMapSizeUnits       = backup->map_size_units;
     gMapSizeMinus2      = backup->map_size_units_minus_2;
     gMapSize            = backup->map_size;
     gCurrentRotation    = backup->current_rotation;
 
+    free(backup->map_elements);
     free(backup);
 }
 
@@ -32,7 +32,9 @@
 #include "../network/network.h"
 #include "../object_list.h"
 #include "../OpenRCT2.h"
+#include "../peep/PathDistanceField.h"
 #include "../peep/Peep.h"
+#include "../peep/PeepSpatialIndex.h"
 #include "../peep/Staff.h"
 #include "../rct1.h"
 #include "../rct2/addresses.h"
@@ -43,6 +45,7 @@
 #include "../world/footpath.h"
 #include "../world/map.h"
 #include "../world/map_animation.h"
+#include "../world/ParkStatistics.h"
 #include "../world/scenery.h"
 #include "../world/sprite.h"
 #include "cable_lift.h"
@@ -1184,6 +1187,7 @@ void ride_remove_peeps(sint32 rideIndex)
             peep->happiness = min(peep->happiness, peep->happiness_target) / 2;
             peep->happiness_target = peep->happiness;
             peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
+            park_statistics_update_peep(peep);
         }
     }
 
@@ -2658,52 +2662,58 @@ rct_peep *ride_find_closest_mechanic(Ride *ride, sint32 forInspection)
     return find_closest_mechanic(x, y, forInspection);
 }
 
-/**
- *
- *  rct2: 0x006B774B (forInspection = 0)
- *  rct2: 0x006B78C3 (forInspection = 1)
- */
-rct_peep *find_closest_mechanic(sint32 x, sint32 y, sint32 forInspection)
-{
-    uint32 closestDistance, distance;
-    uint16 spriteIndex;
-    rct_peep *peep, *closestMechanic = NULL;
+typedef struct mechanic_search_context {
+    sint32 x;
+    sint32 y;
+    bool forInspection;
+    bool locationInPark;
+} mechanic_search_context;
 
-    closestDistance = UINT_MAX;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
+static bool find_closest_mechanic_filter(const rct_peep *peep, const void *context)
+{
+    const mechanic_search_context *search = (const mechanic_search_context *)context;
 
-        if (!forInspection) {
-            if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
-                if (peep->sub_state >= 4)
-                    continue;
-            }
-            else if (peep->state != PEEP_STATE_PATROLLING)
-                continue;
+    if (peep->staff_type != STAFF_TYPE_MECHANIC)
+        return false;
 
-            if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
-                continue;
-        } else {
-            if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
+    if (!search->forInspection) {
+        if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
+            if (peep->sub_state >= 4)
+                return false;
         }
+        else if (peep->state != PEEP_STATE_PATROLLING)
+            return false;
 
-        if (map_is_location_in_park(x, y))
-            if (!staff_is_location_in_patrol(peep, x & 0xFFE0, y & 0xFFE0))
-                continue;
+        if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
+            return false;
+    } else {
+        if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
+            return false;
+    }
 
-        if (peep->x == LOCATION_NULL)
-            continue;
+    if (search->locationInPark)
+        if (!staff_is_location_in_patrol((rct_peep *)peep, search->x & 0xFFE0, search->y & 0xFFE0))
+            return false;
 
-        // Manhattan distance
-        distance = abs(peep->x - x) + abs(peep->y - y);
-        if (distance < closestDistance) {
-            closestDistance = distance;
-            closestMechanic = peep;
-        }
-    }
+    return true;
+}
+
+/**
+ *
+ *  rct2: 0x006B774B (forInspection = 0)
+ *  rct2: 0x006B78C3 (forInspection = 1)
+ */
+rct_peep *find_closest_mechanic(sint32 x, sint32 y, sint32 forInspection)
+{
+    mechanic_search_context context;
+    context.x = x;
+    context.y = y;
+    context.forInspection = forInspection != 0;
+    context.locationInPark = map_is_location_in_park(x, y);
 
+    // Manhattan distance, ties resolved in sprite list order
+    rct_peep *closestMechanic = NULL;
+    peep_spatial_index_find_nearest(PEEP_TYPE_STAFF, x, y, find_closest_mechanic_filter, &context, &closestMechanic, 1);
     return closestMechanic;
 }
 
@@ -5488,6 +5498,7 @@ sint32 ride_get_refund_price(sint32 ride_id)
                 z,
                 0);
             if (removePrice == MONEY32_UNDEFINED) {
+                path_distance_field_invalidate_tile(it.x, it.y);
                 map_element_remove(it.element);
             } else {
                 refundPrice += removePrice;
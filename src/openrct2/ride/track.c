@@ -22,6 +22,7 @@
 #include "../localisation/localisation.h"
 #include "../management/Finance.h"
 #include "../network/network.h"
+#include "../peep/PathDistanceField.h"
 #include "../platform/platform.h"
 #include "../rct1.h"
 #include "../util/sawyercoding.h"
@@ -1637,6 +1638,7 @@ static money32 track_remove(uint8 type, uint8 sequence, sint16 originX, sint16 o
         if (!gCheatsDisableClearanceChecks || !(mapElement->flags & MAP_ELEMENT_FLAG_GHOST)) {
             footpath_remove_edges_at(x, y, mapElement);
         }
+        path_distance_field_invalidate_tile(x >> 5, y >> 5);
         map_element_remove(mapElement);
         if (!(flags & GAME_COMMAND_FLAG_GHOST)){
             sub_6CB945(rideIndex);
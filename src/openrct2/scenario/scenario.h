@@ -412,6 +412,10 @@ uint32 scenario_rand_max(uint32 max);
 
 bool scenario_prepare_for_save();
 sint32 scenario_save(const utf8 * path, sint32 flags);
+bool scenario_save_in_background(const utf8 * path, sint32 flags);
+bool scenario_save_is_in_background();
+void scenario_save_update_background();
+void scenario_save_wait_for_background();
 void scenario_remove_trackless_rides(rct_s6_data *s6);
 void scenario_fix_ghosts(rct_s6_data *s6);
 void scenario_failure();
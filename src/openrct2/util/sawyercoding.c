@@ -21,41 +21,60 @@
 
 static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_t length);
 static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize);
-static size_t decode_chunk_repeat(uint8 *buffer, size_t length, size_t dstLength);
-static void decode_chunk_rotate(uint8 *buffer, size_t length);
+static size_t decode_chunk_rle_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length, size_t dstSize);
+static void decode_chunk_rotate(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
 
 static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
 static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
-static void encode_chunk_rotate(uint8 *buffer, size_t length);
+static void encode_chunk_rotate(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
 
 bool gUseRLE = true;
 
+// Each byte is spread into a 16 bit lane, so 128 words can be summed before a lane can overflow
+#define CHECKSUM_WORDS_PER_FOLD 128
+#define LANES_0x00FF 0x00FF00FF00FF00FFULL
+
 uint32 sawyercoding_calculate_checksum(const uint8* buffer, size_t length)
 {
-    size_t i;
+    size_t i = 0;
     uint32 checksum = 0;
-    for (i = 0; i < length; i++)
+    while (length - i >= sizeof(uint64)) {
+        size_t numWords = min((length - i) / sizeof(uint64), CHECKSUM_WORDS_PER_FOLD);
+        uint64 lanes = 0;
+        for (size_t j = 0; j < numWords; j++, i += sizeof(uint64)) {
+            uint64 word;
+            memcpy(&word, &buffer[i], sizeof(uint64));
+            lanes += (word & LANES_0x00FF) + ((word >> 8) & LANES_0x00FF);
+        }
+        lanes = (lanes & 0x0000FFFF0000FFFFULL) + ((lanes >> 16) & 0x0000FFFF0000FFFFULL);
+        checksum += (uint32)lanes + (uint32)(lanes >> 32);
+    }
+    for (; i < length; i++)
         checksum += buffer[i];
 
     return checksum;
 }
 
+/**
+ * Decodes a chunk into dst_buffer. Any data that decodes past dst_buffer_size is discarded, so the chunk can be
+ * decoded straight into a fixed size destination such as a struct.
+ * @returns the number of bytes written to dst_buffer.
+ */
 size_t sawyercoding_read_chunk_buffer(uint8 *dst_buffer, const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader, size_t dst_buffer_size) {
     switch (chunkHeader.encoding) {
     case CHUNK_ENCODING_NONE:
-        assert(chunkHeader.length <= dst_buffer_size);
+        chunkHeader.length = (uint32)min(chunkHeader.length, dst_buffer_size);
         memcpy(dst_buffer, src_buffer, chunkHeader.length);
         break;
     case CHUNK_ENCODING_RLE:
         chunkHeader.length = (uint32)decode_chunk_rle_with_size(src_buffer, dst_buffer, chunkHeader.length, dst_buffer_size);
         break;
     case CHUNK_ENCODING_RLECOMPRESSED:
-        chunkHeader.length = (uint32)decode_chunk_rle_with_size(src_buffer, dst_buffer, chunkHeader.length, dst_buffer_size);
-        chunkHeader.length = (uint32)decode_chunk_repeat(dst_buffer, chunkHeader.length, dst_buffer_size);
+        chunkHeader.length = (uint32)decode_chunk_rle_repeat(src_buffer, dst_buffer, chunkHeader.length, dst_buffer_size);
         break;
     case CHUNK_ENCODING_ROTATE:
-        memcpy(dst_buffer, src_buffer, chunkHeader.length);
-        decode_chunk_rotate(dst_buffer, chunkHeader.length);
+        chunkHeader.length = (uint32)min(chunkHeader.length, dst_buffer_size);
+        decode_chunk_rotate(src_buffer, dst_buffer, chunkHeader.length);
         break;
     }
     return chunkHeader.length;
@@ -104,14 +123,9 @@ size_t sawyercoding_write_chunk_buffer(uint8 *dst_file, const uint8* buffer, saw
         free(encode_buffer);
         break;
     case CHUNK_ENCODING_ROTATE:
-        encode_buffer = malloc(chunkHeader.length);
-        memcpy(encode_buffer, buffer, chunkHeader.length);
-        encode_chunk_rotate(encode_buffer, chunkHeader.length);
         memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
         dst_file += sizeof(sawyercoding_chunk_header);
-        memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-        free(encode_buffer);
+        encode_chunk_rotate(buffer, dst_file, chunkHeader.length);
         break;
     }
 
@@ -239,26 +253,26 @@ static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_
 static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize)
 {
     size_t count;
-    uint8 *dst, rleCodeByte;
+    uint8 *dst, *dstEnd, rleCodeByte;
 
     dst = dst_buffer;
+    dstEnd = dst_buffer + dstSize;
 
     assert(length > 0);
     assert(dstSize > 0);
-    for (size_t i = 0; i < length; i++) {
+    for (size_t i = 0; i < length && dst < dstEnd; i++) {
         rleCodeByte = src_buffer[i];
         if (rleCodeByte & 128) {
             i++;
-            count = 257 - rleCodeByte;
-            assert(dst + count <= dst_buffer + dstSize);
+            count = min(257 - rleCodeByte, (size_t)(dstEnd - dst));
             assert(i < length);
             memset(dst, src_buffer[i], count);
-            dst = (uint8*)((uintptr_t)dst + count);
+            dst += count;
         } else {
-            assert(dst + rleCodeByte + 1 <= dst_buffer + dstSize);
+            count = min(rleCodeByte + 1, (size_t)(dstEnd - dst));
             assert(i + 1 < length);
-            memcpy(dst, src_buffer + i + 1, rleCodeByte + 1);
-            dst = (uint8*)((uintptr_t)dst + rleCodeByte + 1);
+            memcpy(dst, src_buffer + i + 1, count);
+            dst += count;
             i += rleCodeByte + 1;
         }
     }
@@ -267,50 +281,126 @@ static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buf
     return dst - dst_buffer;
 }
 
+typedef struct repeat_decoder {
+    uint8 *start;
+    uint8 *dst;
+    uint8 *end;
+    bool literal;
+} repeat_decoder;
+
 /**
- *
- *  rct2: 0x006769F1
+ * Feeds one byte of RLE decoded data into the repeat decoder.
+ * @returns false if the destination is full or the data is corrupt.
  */
-static size_t decode_chunk_repeat(uint8 *buffer, size_t length, size_t dstLength)
+static inline bool decode_repeat_byte(repeat_decoder *decoder, uint8 code)
 {
-    size_t i, count;
-    uint8 *src, *dst, *copyOffset;
+    if (decoder->literal) {
+        decoder->literal = false;
+        *decoder->dst++ = code;
+        return decoder->dst < decoder->end;
+    } else if (code == 0xFF) {
+        decoder->literal = true;
+        return true;
+    }
 
-    // Backup buffer
-    src = malloc(length);
-    memcpy(src, buffer, length);
-    dst = buffer;
+    size_t count = (code & 7) + 1;
+    size_t offset = 32 - (code >> 3);
+    size_t remaining = decoder->end - decoder->dst;
+    if (offset > (size_t)(decoder->dst - decoder->start)) {
+        assert(false);
+        return false;
+    }
 
-    for (i = 0; i < length; i++) {
-        if (src[i] == 0xFF) {
-            *dst++ = src[++i];
+    const uint8 *copySrc = decoder->dst - offset;
+    if (offset >= 8 && remaining >= 8) {
+        // Copy a whole word, anything past count is overwritten by the next code
+        memcpy(decoder->dst, copySrc, 8);
+    } else {
+        // Overlapping repeat, copy forwards one byte at a time
+        for (size_t i = 0; i < min(count, remaining); i++)
+            decoder->dst[i] = copySrc[i];
+    }
+    if (count >= remaining) {
+        decoder->dst = decoder->end;
+        return false;
+    }
+    decoder->dst += count;
+    return true;
+}
+
+/**
+ * Decodes the RLE and repeat layers of a chunk in a single pass, straight into the destination.
+ *
+ *  rct2: 0x0067693A, 0x006769F1
+ */
+static size_t decode_chunk_rle_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length, size_t dstSize)
+{
+    repeat_decoder decoder = { dst_buffer, dst_buffer, dst_buffer + dstSize, false };
+
+    assert(length > 0);
+    assert(dstSize > 0);
+    for (size_t i = 0; i < length; ) {
+        uint8 rleCodeByte = src_buffer[i++];
+        if (rleCodeByte & 128) {
+            assert(i < length);
+            uint8 value = src_buffer[i++];
+            for (sint32 count = 257 - rleCodeByte; count > 0; count--) {
+                if (!decode_repeat_byte(&decoder, value))
+                    return decoder.dst - dst_buffer;
+            }
         } else {
-            count = (src[i] & 7) + 1;
-            copyOffset = dst + (sint32)(src[i] >> 3) - 32;
-            assert(dst + count < buffer + dstLength);
-            assert(copyOffset + count < buffer + dstLength);
-            memcpy(dst, copyOffset, count);
-            dst = (uint8*)((uintptr_t)dst + count);
+            size_t count = rleCodeByte + 1;
+            assert(i + count <= length);
+            count = min(count, length - i);
+            for (size_t j = 0; j < count; j++) {
+                if (!decode_repeat_byte(&decoder, src_buffer[i + j]))
+                    return decoder.dst - dst_buffer;
+            }
+            i += count;
         }
     }
 
-    // Free backup buffer
-    free(src);
-
     // Return final size
-    return dst - buffer;
+    return decoder.dst - dst_buffer;
+}
+
+#define LANES_0x01 0x0101010101010101ULL
+// Byte lanes that are rotated by 1, 3, 5 and 7 bits, the rotation pattern repeats every four bytes
+#define LANE_MASK_ROTATE_1 0x000000FF000000FFULL
+#define LANE_MASK_ROTATE_3 0x0000FF000000FF00ULL
+#define LANE_MASK_ROTATE_5 0x00FF000000FF0000ULL
+#define LANE_MASK_ROTATE_7 0xFF000000FF000000ULL
+
+/**
+ * Rotates each byte selected by laneMask right by shift bits, eight bytes at a time.
+ */
+static inline uint64 ror8_lanes(uint64 value, sint32 shift, uint64 laneMask)
+{
+    uint64 lowMask = LANES_0x01 * (0xFF >> shift);
+    uint64 highMask = LANES_0x01 * ((0xFF << (8 - shift)) & 0xFF);
+    return (((value >> shift) & lowMask) | ((value << (8 - shift)) & highMask)) & laneMask;
 }
 
 /**
  *
  *  rct2: 0x006768F4
  */
-static void decode_chunk_rotate(uint8 *buffer, size_t length)
+static void decode_chunk_rotate(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
     size_t i;
+    for (i = 0; i + sizeof(uint64) <= length; i += sizeof(uint64)) {
+        uint64 word;
+        memcpy(&word, &src_buffer[i], sizeof(uint64));
+        word = ror8_lanes(word, 1, LANE_MASK_ROTATE_1) |
+               ror8_lanes(word, 3, LANE_MASK_ROTATE_3) |
+               ror8_lanes(word, 5, LANE_MASK_ROTATE_5) |
+               ror8_lanes(word, 7, LANE_MASK_ROTATE_7);
+        memcpy(&dst_buffer[i], &word, sizeof(uint64));
+    }
+
     uint8 code = 1;
-    for (i = 0; i < length; i++) {
-        buffer[i] = ror8(buffer[i], code);
+    for (; i < length; i++) {
+        dst_buffer[i] = ror8(src_buffer[i], code);
         code = (code + 2) % 8;
     }
 }
@@ -366,69 +456,91 @@ static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_
     return dst - dst_buffer;
 }
 
+#define REPEAT_WINDOW_SIZE 32
+#define REPEAT_MAX_LENGTH 8
+
+/**
+ * Encodes repeats of up to 8 bytes from the previous 32 bytes. Candidate positions are found through a chain of
+ * previous positions that start with the same byte, rather than comparing against every position in the window.
+ * The oldest of the longest matches is used so that the output matches the original search.
+ */
 static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
     if (length == 0)
         return 0;
 
-    size_t outLength = 0;
+    // Most recent position + 1 of each byte value, 0 if it has not been seen yet
+    size_t head[256] = { 0 };
+    // Previous position + 1 with the same byte value, indexed by position within the window
+    size_t chain[REPEAT_WINDOW_SIZE];
+
+    uint8 *dst = dst_buffer;
 
     // Need to emit at least one byte, otherwise there is nothing to repeat
-    *dst_buffer++ = 255;
-    *dst_buffer++ = src_buffer[0];
-    outLength += 2;
+    *dst++ = 255;
+    *dst++ = src_buffer[0];
+    chain[0] = 0;
+    head[src_buffer[0]] = 1;
 
     // Iterate through remainder of the source buffer
     for (size_t i = 1; i < length; ) {
-        size_t searchIndex = (i < 32) ? 0 : (i - 32);
-        size_t searchEnd = i - 1;
+        size_t searchIndex = (i < REPEAT_WINDOW_SIZE) ? 0 : (i - REPEAT_WINDOW_SIZE);
+        size_t maxRepeatCount = min(REPEAT_MAX_LENGTH, length - i);
 
         size_t bestRepeatIndex = 0;
         size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++) {
-            size_t repeatCount = 0;
-            size_t maxRepeatCount = min(min(7, searchEnd - repeatIndex), length - i - 1);
-            // maxRepeatCount should not exceed length
-            assert(repeatIndex + maxRepeatCount < length);
-            assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++) {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j]) {
+        for (size_t candidate = head[src_buffer[i]]; candidate > searchIndex; ) {
+            size_t repeatIndex = candidate - 1;
+            size_t repeatMax = min(maxRepeatCount, i - repeatIndex);
+            size_t repeatCount = 1;
+            if (repeatMax == REPEAT_MAX_LENGTH && memcmp(&src_buffer[repeatIndex], &src_buffer[i], REPEAT_MAX_LENGTH) == 0) {
+                repeatCount = REPEAT_MAX_LENGTH;
+            } else {
+                while (repeatCount < repeatMax && src_buffer[repeatIndex + repeatCount] == src_buffer[i + repeatCount])
                     repeatCount++;
-                } else {
-                    break;
-                }
             }
-            if (repeatCount > bestRepeatCount) {
+            if (repeatCount >= bestRepeatCount) {
                 bestRepeatIndex = repeatIndex;
                 bestRepeatCount = repeatCount;
-
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
-                    break;
             }
+            candidate = chain[repeatIndex % REPEAT_WINDOW_SIZE];
         }
 
+        size_t advance;
         if (bestRepeatCount == 0) {
-            *dst_buffer++ = 255;
-            *dst_buffer++ = src_buffer[i];
-            outLength += 2;
-            i++;
+            *dst++ = 255;
+            *dst++ = src_buffer[i];
+            advance = 1;
         } else {
-            *dst_buffer++ = (uint8)((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
-            outLength++;
-            i += bestRepeatCount;
+            *dst++ = (uint8)((bestRepeatCount - 1) | ((REPEAT_WINDOW_SIZE - (i - bestRepeatIndex)) << 3));
+            advance = bestRepeatCount;
+        }
+
+        for (; advance > 0; advance--, i++) {
+            chain[i % REPEAT_WINDOW_SIZE] = head[src_buffer[i]];
+            head[src_buffer[i]] = i + 1;
         }
     }
 
-    return outLength;
+    return dst - dst_buffer;
 }
 
-static void encode_chunk_rotate(uint8 *buffer, size_t length)
+static void encode_chunk_rotate(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
     size_t i;
+    for (i = 0; i + sizeof(uint64) <= length; i += sizeof(uint64)) {
+        uint64 word;
+        memcpy(&word, &src_buffer[i], sizeof(uint64));
+        word = ror8_lanes(word, 7, LANE_MASK_ROTATE_1) |
+               ror8_lanes(word, 5, LANE_MASK_ROTATE_3) |
+               ror8_lanes(word, 3, LANE_MASK_ROTATE_5) |
+               ror8_lanes(word, 1, LANE_MASK_ROTATE_7);
+        memcpy(&dst_buffer[i], &word, sizeof(uint64));
+    }
+
     uint8 code = 1;
-    for (i = 0; i < length; i++) {
-        buffer[i] = rol8(buffer[i], code);
+    for (; i < length; i++) {
+        dst_buffer[i] = rol8(src_buffer[i], code);
         code = (code + 2) % 8;
     }
 }
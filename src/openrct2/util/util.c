@@ -182,6 +182,7 @@ sint32 bitscanforward(sint32 source)
     #define OpenRCT2_POPCNT_GNUC
 #elif defined(_MSC_VER) && (_MSC_VER >= 1500) && (defined(_M_X64) || defined(_M_IX86)) // VS2008
     #include <nmmintrin.h>
+    #include <immintrin.h>
     #define OpenRCT2_POPCNT_MSVC
 #endif
 
@@ -203,6 +204,57 @@ static bool bitcount_popcnt_available()
     #endif
 }
 
+/**
+ * AVX2 needs both the CPU flag (CPUID(EAX = 7, ECX = 0), EBX bit 5) and the OS saving the YMM
+ * registers on context switches, which is reported through XGETBV.
+ */
+bool avx2_available()
+{
+    #if defined(OpenRCT2_POPCNT_GNUC)
+        uint32 eax, ebx, ecx = 0, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1 << 27)))
+            return false;
+
+        uint32 xcr0, xcr0High;
+        asm volatile ("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+        if ((xcr0 & 6) != 6)
+            return false;
+
+        // __get_cpuid_count only exists since GCC 7, use the older macro instead
+        if (__get_cpuid_max(0, NULL) < 7)
+            return false;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (ebx & (1 << 5));
+    #elif defined(OpenRCT2_POPCNT_MSVC)
+        sint32 regs[4];
+        __cpuid(regs, 1);
+        if (!(regs[2] & (1 << 27)))
+            return false;
+        if ((_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5));
+    #else
+        return false;
+    #endif
+}
+
+bool sse2_available()
+{
+    // SSE2 support is declared as the 26th bit of EDX with CPUID(EAX = 1).
+    #if defined(OpenRCT2_POPCNT_GNUC)
+        uint32 eax, ebx, ecx, edx = 0;
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+        return (edx & (1 << 26));
+    #elif defined(OpenRCT2_POPCNT_MSVC)
+        sint32 regs[4];
+        __cpuid(regs, 1);
+        return (regs[3] & (1 << 26));
+    #else
+        return false;
+    #endif
+}
+
 static sint32 bitcount_popcnt(uint32 source)
 {
     #if defined(OpenRCT2_POPCNT_GNUC)
@@ -493,6 +545,19 @@ uint8 *util_zlib_deflate(const uint8 *data, size_t data_in_size, size_t *data_ou
     return buffer;
 }
 
+uint32 util_zlib_crc32(const uint8 *data, size_t length)
+{
+    uLong crc = crc32(0L, Z_NULL, 0);
+    // crc32 takes a 32 bit length, so feed larger buffers in parts
+    while (length > 0) {
+        uInt partLength = (uInt)min(length, UINT32_MAX);
+        crc = crc32(crc, data, partLength);
+        data += partLength;
+        length -= partLength;
+    }
+    return (uint32)crc;
+}
+
 // Type-independent code left as macro to reduce duplicate code.
 #define add_clamp_body(value, value_to_add, min_cap, max_cap) \
     if ((value_to_add > 0) && (value > (max_cap - value_to_add))) { \
@@ -44,6 +44,8 @@ bool writeentirefile(const utf8 * path, const void * buffer, size_t length);
 sint32 bitscanforward(sint32 source);
 void bitcount_init();
 sint32 bitcount(uint32 source);
+bool sse2_available();
+bool avx2_available();
 bool strequals(const char *a, const char *b, sint32 length, bool caseInsensitive);
 sint32 strcicmp(char const *a, char const *b);
 sint32 strlogicalcmp(char const *a, char const *b);
@@ -61,6 +63,7 @@ uint32 util_rand();
 
 uint8 *util_zlib_deflate(const uint8 *data, size_t data_in_size, size_t *data_out_size);
 uint8 *util_zlib_inflate(uint8 *data, size_t data_in_size, size_t *data_out_size);
+uint32 util_zlib_crc32(const uint8 *data, size_t length);
 
 sint8 add_clamp_sint8(sint8 value, sint8 value_to_add);
 sint16 add_clamp_sint16(sint16 value, sint16 value_to_add);
@@ -19,6 +19,7 @@
 #include "../core/Util.hpp"
 #include "../core/String.hpp"
 #include "../network/network.h"
+#include "../peep/PathDistanceField.h"
 
 #include "banner.h"
 #include "map.h"
@@ -110,6 +111,7 @@ static money32 BannerRemove(sint16 x, sint16 y, uint8 baseHeight, uint8 directio
 
         map_element_remove_banner_entry(mapElement);
         map_invalidate_tile_zoom1(x, y, z, z + 32);
+        path_distance_field_invalidate_tile(x >> 5, y >> 5);
         map_element_remove(mapElement);
     }
 
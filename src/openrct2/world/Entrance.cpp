@@ -16,6 +16,7 @@
 
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../peep/PathDistanceField.h"
 
 #include "entrance.h"
 #include "footpath.h"
@@ -46,6 +47,7 @@ static void ParkEntranceRemoveSegment(sint32 x, sint32 y, sint32 z)
     }
 
     map_invalidate_tile(x, y, mapElement->base_height * 8, mapElement->clearance_height * 8);
+    path_distance_field_invalidate_tile(x >> 5, y >> 5);
     map_element_remove(mapElement);
     update_park_fences(x, y);
 }
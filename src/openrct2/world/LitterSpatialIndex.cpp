@@ -0,0 +1,259 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include "../core/Math.hpp"
+#include "LitterSpatialIndex.h"
+
+constexpr sint32 TILES_PER_AXIS = MAXIMUM_MAP_SIZE_TECHNICAL;
+constexpr sint32 TILE_COUNT = TILES_PER_AXIS * TILES_PER_AXIS;
+constexpr uint16 TILE_NULL = 0xFFFF;
+
+static uint16 _tileHeads[TILE_COUNT];
+static uint16 _nextOnTile[MAX_SPRITES];
+static uint16 _previousOnTile[MAX_SPRITES];
+static uint16 _spriteTile[MAX_SPRITES];
+static bool _indexValid;
+
+static sint32 GetTileCoordinate(sint32 value)
+{
+    return Math::Clamp(0, value >> 5, TILES_PER_AXIS - 1);
+}
+
+static uint16 GetTile(const rct_litter * litter)
+{
+    if (litter->x == LOCATION_NULL)
+    {
+        return TILE_NULL;
+    }
+    return (uint16)(GetTileCoordinate(litter->x) * TILES_PER_AXIS + GetTileCoordinate(litter->y));
+}
+
+static void RemoveFromTile(uint16 spriteIndex)
+{
+    uint16 tile = _spriteTile[spriteIndex];
+    if (tile == TILE_NULL)
+    {
+        return;
+    }
+
+    uint16 previous = _previousOnTile[spriteIndex];
+    uint16 next = _nextOnTile[spriteIndex];
+    if (previous == SPRITE_INDEX_NULL)
+    {
+        _tileHeads[tile] = next;
+    }
+    else
+    {
+        _nextOnTile[previous] = next;
+    }
+    if (next != SPRITE_INDEX_NULL)
+    {
+        _previousOnTile[next] = previous;
+    }
+    _spriteTile[spriteIndex] = TILE_NULL;
+}
+
+static void AddToTile(uint16 spriteIndex, uint16 tile)
+{
+    uint16 head = _tileHeads[tile];
+    _previousOnTile[spriteIndex] = SPRITE_INDEX_NULL;
+    _nextOnTile[spriteIndex] = head;
+    if (head != SPRITE_INDEX_NULL)
+    {
+        _previousOnTile[head] = spriteIndex;
+    }
+    _tileHeads[tile] = spriteIndex;
+    _spriteTile[spriteIndex] = tile;
+}
+
+static void RebuildIndex()
+{
+    std::fill_n(_tileHeads, TILE_COUNT, SPRITE_INDEX_NULL);
+    std::fill_n(_spriteTile, MAX_SPRITES, TILE_NULL);
+
+    for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+    {
+        rct_litter * litter = &get_sprite(spriteIndex)->litter;
+        uint16 tile = GetTile(litter);
+        if (tile != TILE_NULL)
+        {
+            AddToTile(spriteIndex, tile);
+        }
+        spriteIndex = litter->next;
+    }
+    _indexValid = true;
+}
+
+static void EnsureIndexValid()
+{
+    if (!_indexValid)
+    {
+        RebuildIndex();
+    }
+}
+
+static sint32 GetDistance(const rct_litter * litter, sint32 x, sint32 y, sint32 z)
+{
+    return abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+}
+
+static bool IsInArea(const rct_litter * litter, sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    return litter->x >= left && litter->x <= right && litter->y >= top && litter->y <= bottom;
+}
+
+extern "C"
+{
+    void litter_spatial_index_invalidate()
+    {
+        _indexValid = false;
+    }
+
+    /**
+     * Called by sprite_move whenever litter is placed, including when it is created.
+     */
+    void litter_spatial_index_update(rct_litter * litter)
+    {
+        if (!_indexValid)
+        {
+            return;
+        }
+
+        uint16 spriteIndex = litter->sprite_index;
+        uint16 tile = GetTile(litter);
+        if (tile == _spriteTile[spriteIndex])
+        {
+            return;
+        }
+
+        RemoveFromTile(spriteIndex);
+        if (tile != TILE_NULL)
+        {
+            AddToTile(spriteIndex, tile);
+        }
+    }
+
+    void litter_spatial_index_remove(rct_litter * litter)
+    {
+        if (_indexValid)
+        {
+            RemoveFromTile(litter->sprite_index);
+        }
+    }
+
+    rct_litter * litter_spatial_index_find_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance)
+    {
+        EnsureIndexValid();
+
+        rct_litter * nearestLitter = nullptr;
+        sint32 nearestDistance = maxDistance + 1;
+        bool hasTies = false;
+
+        sint32 tileLeft = GetTileCoordinate(x - maxDistance);
+        sint32 tileRight = GetTileCoordinate(x + maxDistance);
+        sint32 tileTop = GetTileCoordinate(y - maxDistance);
+        sint32 tileBottom = GetTileCoordinate(y + maxDistance);
+        for (sint32 tileX = tileLeft; tileX <= tileRight; tileX++)
+        {
+            for (sint32 tileY = tileTop; tileY <= tileBottom; tileY++)
+            {
+                uint16 spriteIndex = _tileHeads[tileX * TILES_PER_AXIS + tileY];
+                while (spriteIndex != SPRITE_INDEX_NULL)
+                {
+                    rct_litter * litter = &get_sprite(spriteIndex)->litter;
+                    sint32 distance = GetDistance(litter, x, y, z);
+                    if (distance < nearestDistance)
+                    {
+                        nearestDistance = distance;
+                        nearestLitter = litter;
+                        hasTies = false;
+                    }
+                    else if (distance == nearestDistance && nearestLitter != nullptr)
+                    {
+                        hasTies = true;
+                    }
+                    spriteIndex = _nextOnTile[spriteIndex];
+                }
+            }
+        }
+
+        // The first litter in the list at the nearest distance wins, the list is only walked when needed
+        if (hasTies)
+        {
+            for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+            {
+                rct_litter * litter = &get_sprite(spriteIndex)->litter;
+                if (_spriteTile[spriteIndex] != TILE_NULL && GetDistance(litter, x, y, z) == nearestDistance)
+                {
+                    nearestLitter = litter;
+                    break;
+                }
+                spriteIndex = litter->next;
+            }
+        }
+        return nearestLitter;
+    }
+
+    sint32 litter_spatial_index_count(sint32 left, sint32 top, sint32 right, sint32 bottom, litter_spatial_index_filter filter, const void * context, sint32 maxCount)
+    {
+        EnsureIndexValid();
+
+        sint32 count = 0;
+        sint32 tileLeft = GetTileCoordinate(left);
+        sint32 tileRight = GetTileCoordinate(right);
+        sint32 tileTop = GetTileCoordinate(top);
+        sint32 tileBottom = GetTileCoordinate(bottom);
+        sint32 numTiles = (tileRight - tileLeft + 1) * (tileBottom - tileTop + 1);
+
+        // Large areas such as the whole park are quicker to count from the litter list itself
+        if (numTiles > gSpriteListCount[SPRITE_LIST_LITTER])
+        {
+            for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL && count < maxCount;)
+            {
+                rct_litter * litter = &get_sprite(spriteIndex)->litter;
+                if (IsInArea(litter, left, top, right, bottom) && (filter == nullptr || filter(litter, context)))
+                {
+                    count++;
+                }
+                spriteIndex = litter->next;
+            }
+            return count;
+        }
+
+        for (sint32 tileX = tileLeft; tileX <= tileRight; tileX++)
+        {
+            for (sint32 tileY = tileTop; tileY <= tileBottom; tileY++)
+            {
+                uint16 spriteIndex = _tileHeads[tileX * TILES_PER_AXIS + tileY];
+                while (spriteIndex != SPRITE_INDEX_NULL)
+                {
+                    rct_litter * litter = &get_sprite(spriteIndex)->litter;
+                    if (IsInArea(litter, left, top, right, bottom) && (filter == nullptr || filter(litter, context)))
+                    {
+                        count++;
+                        if (count >= maxCount)
+                        {
+                            return count;
+                        }
+                    }
+                    spriteIndex = _nextOnTile[spriteIndex];
+                }
+            }
+        }
+        return count;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _LITTER_SPATIAL_INDEX_H_
+#define _LITTER_SPATIAL_INDEX_H_
+
+#include "../common.h"
+#include "sprite.h"
+
+typedef bool (*litter_spatial_index_filter)(const rct_litter * litter, const void * context);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void litter_spatial_index_invalidate();
+void litter_spatial_index_update(rct_litter * litter);
+void litter_spatial_index_remove(rct_litter * litter);
+
+/**
+ * Finds the litter nearest to the given point, measured as the x and y distance plus four times
+ * the z distance. Litter at an equal distance is ordered as it appears in the litter sprite list,
+ * which matches the result of a linear search of the list.
+ * @returns NULL if there is no litter within maxDistance.
+ */
+rct_litter * litter_spatial_index_find_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance);
+
+/**
+ * Counts the litter accepted by the filter within the given inclusive area, stopping once
+ * maxCount has been reached.
+ */
+sint32 litter_spatial_index_count(sint32 left, sint32 top, sint32 right, sint32 bottom, litter_spatial_index_filter filter, const void * context, sint32 maxCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,254 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <vector>
+#include "../ride/TrackDesign.h"
+#include "map.h"
+
+constexpr uint8 REMOVED_ELEMENT_HEIGHT = 255;
+constexpr uint32 NO_TILE = 0xFFFFFFFF;
+
+// The compactor sweeps the store from the first removed element upwards, sliding each tile's
+// elements down to the write position. The tile owning each element is found through a table
+// built when the sweep starts, so the sweep visits tiles in the order they are stored.
+static std::vector<uint32> _tileAtOffset;
+static uint32 _sweepStart;
+static uint32 _readOffset;
+static uint32 _writeOffset;
+static bool   _sweepActive;
+static bool   _elementsRemoved = true;
+static uint32 _sweepsCompleted;
+static uint32 _tilesMoved;
+
+static bool IsRemoved(const rct_map_element * mapElement)
+{
+    return mapElement->base_height == REMOVED_ELEMENT_HEIGHT;
+}
+
+static uint32 GetUsedElementCount()
+{
+    return (uint32)(gNextFreeMapElement - gMapElements);
+}
+
+static void ReleaseTrailingRemovedElements()
+{
+    rct_map_element * mapElement = gNextFreeMapElement;
+    while (mapElement > gMapElements && IsRemoved(mapElement - 1))
+    {
+        mapElement--;
+    }
+    gNextFreeMapElement = mapElement;
+}
+
+static void CancelSweep()
+{
+    _sweepActive = false;
+    _tileAtOffset.clear();
+}
+
+static bool BeginSweep()
+{
+    CancelSweep();
+
+    // Everything before the first removed element is already compact
+    uint32 usedElements = GetUsedElementCount();
+    uint32 firstRemoved = 0;
+    while (firstRemoved < usedElements && !IsRemoved(&gMapElements[firstRemoved]))
+    {
+        firstRemoved++;
+    }
+    if (firstRemoved == usedElements)
+    {
+        return false;
+    }
+
+    _tileAtOffset.assign(usedElements - firstRemoved, NO_TILE);
+    for (uint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++)
+    {
+        rct_map_element * mapElement = gMapElementTilePointers[i];
+        if (mapElement == TILE_UNDEFINED_MAP_ELEMENT)
+        {
+            continue;
+        }
+
+        uint32 offset = (uint32)(mapElement - gMapElements);
+        if (offset > firstRemoved && offset < usedElements)
+        {
+            _tileAtOffset[offset - firstRemoved] = i;
+        }
+    }
+
+    _sweepStart = firstRemoved;
+    _readOffset = firstRemoved;
+    _writeOffset = firstRemoved;
+    _sweepActive = true;
+    return true;
+}
+
+static void EndSweep()
+{
+    CancelSweep();
+    ReleaseTrailingRemovedElements();
+    _sweepsCompleted++;
+}
+
+/**
+ * Slides the elements of the tile starting at the given offset down to the write position.
+ * @returns false if the store no longer matches the state the sweep started with.
+ */
+static bool MoveTile(uint32 tileIndex, uint32 offset)
+{
+    rct_map_element * source = gMapElements + offset;
+    if (gMapElementTilePointers[tileIndex] != source)
+    {
+        // The tile was moved by an insert since the sweep started, leaving removed elements behind
+        return true;
+    }
+
+    // Only removed elements may be overwritten
+    for (uint32 i = _writeOffset; i < offset; i++)
+    {
+        if (!IsRemoved(&gMapElements[i]))
+        {
+            return false;
+        }
+    }
+
+    rct_map_element * destination = gMapElements + _writeOffset;
+    if (destination == source)
+    {
+        while (!map_element_is_last_for_tile(destination++));
+    }
+    else
+    {
+        gMapElementTilePointers[tileIndex] = destination;
+        do
+        {
+            *destination = *source;
+            source->base_height = REMOVED_ELEMENT_HEIGHT;
+            source++;
+        }
+        while (!map_element_is_last_for_tile(destination++));
+        _tilesMoved++;
+    }
+    _writeOffset = (uint32)(destination - gMapElements);
+    return true;
+}
+
+extern "C"
+{
+    /**
+     * Relocates up to the given number of tiles towards the start of the element store, moving
+     * the free space to the end where new elements are inserted. Element pointers are invalidated.
+     */
+    void map_compact_elements(sint32 maxTiles)
+    {
+        if (gTrackDesignSaveMode)
+        {
+            return;
+        }
+
+        if (!_sweepActive)
+        {
+            if (!_elementsRemoved)
+            {
+                return;
+            }
+            _elementsRemoved = false;
+            if (!BeginSweep())
+            {
+                ReleaseTrailingRemovedElements();
+                return;
+            }
+        }
+
+        uint32 sweepEnd = _sweepStart + (uint32)_tileAtOffset.size();
+        sint32 tilesVisited = 0;
+        while (tilesVisited < maxTiles)
+        {
+            while (_readOffset < sweepEnd && _tileAtOffset[_readOffset - _sweepStart] == NO_TILE)
+            {
+                _readOffset++;
+            }
+            if (_readOffset >= sweepEnd)
+            {
+                EndSweep();
+                return;
+            }
+
+            uint32 tileIndex = _tileAtOffset[_readOffset - _sweepStart];
+            if (!MoveTile(tileIndex, _readOffset))
+            {
+                // Something other than the compactor rearranged the store, start again
+                CancelSweep();
+                _elementsRemoved = true;
+                return;
+            }
+            _readOffset++;
+            tilesVisited++;
+        }
+    }
+
+    /**
+     * Called whenever elements are marked as removed so the compactor knows to run another sweep.
+     */
+    void map_compaction_notify_removed()
+    {
+        _elementsRemoved = true;
+    }
+
+    /**
+     * Discards the current sweep, used when the whole store has been rewritten.
+     */
+    void map_compaction_reset()
+    {
+        CancelSweep();
+        _elementsRemoved = true;
+    }
+
+    void map_get_element_store_stats(map_element_store_stats * stats)
+    {
+        uint32 usedElements = GetUsedElementCount();
+
+        *stats = { 0 };
+        stats->capacity = gMapElementsCapacity;
+        stats->used = usedElements;
+        stats->live = map_count_elements();
+
+        uint32 gapLength = 0;
+        for (uint32 i = 0; i <= usedElements; i++)
+        {
+            if (i < usedElements && IsRemoved(&gMapElements[i]))
+            {
+                stats->removed++;
+                gapLength++;
+            }
+            else if (gapLength != 0)
+            {
+                stats->gaps++;
+                if (gapLength > stats->largest_gap)
+                {
+                    stats->largest_gap = gapLength;
+                }
+                gapLength = 0;
+            }
+        }
+
+        stats->sweeps = _sweepsCompleted;
+        stats->tiles_moved = _tilesMoved;
+        stats->compacting = _sweepActive;
+    }
+}
@@ -0,0 +1,229 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <iterator>
+#include "../world/sprite.h"
+#include "ParkStatistics.h"
+
+enum PEEP_CONTRIBUTION_FLAGS
+{
+    PEEP_CONTRIBUTION_COUNTED        = (1 << 0),
+    PEEP_CONTRIBUTION_GUEST          = (1 << 1),
+    PEEP_CONTRIBUTION_IN_PARK        = (1 << 2),
+    PEEP_CONTRIBUTION_HAPPY          = (1 << 3),
+    PEEP_CONTRIBUTION_LOST           = (1 << 4),
+    PEEP_CONTRIBUTION_RECENT_THOUGHT = (1 << 5),
+    PEEP_CONTRIBUTION_STAFF          = (1 << 6),
+};
+
+struct PeepContribution
+{
+    uint8 Flags;
+    uint8 Thought;
+    uint8 StaffType;
+};
+
+static park_guest_statistics _statistics;
+static PeepContribution _contributions[MAX_SPRITES];
+static bool _statisticsValid;
+static bool _verify;
+static uint32 _mismatchCount;
+
+static PeepContribution GetContribution(const rct_peep * peep)
+{
+    PeepContribution contribution = { PEEP_CONTRIBUTION_COUNTED, 0, 0 };
+    if (peep->type == PEEP_TYPE_STAFF)
+    {
+        contribution.Flags |= PEEP_CONTRIBUTION_STAFF;
+        contribution.StaffType = peep->staff_type;
+        return contribution;
+    }
+
+    contribution.Flags |= PEEP_CONTRIBUTION_GUEST;
+    if (peep->type != PEEP_TYPE_GUEST || peep->outside_of_park != 0)
+    {
+        return contribution;
+    }
+
+    contribution.Flags |= PEEP_CONTRIBUTION_IN_PARK;
+    if (peep->happiness > 128)
+    {
+        contribution.Flags |= PEEP_CONTRIBUTION_HAPPY;
+    }
+    if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && peep->peep_is_lost_countdown < 90)
+    {
+        contribution.Flags |= PEEP_CONTRIBUTION_LOST;
+    }
+    if (peep->thoughts[0].var_2 <= 5)
+    {
+        contribution.Flags |= PEEP_CONTRIBUTION_RECENT_THOUGHT;
+        contribution.Thought = peep->thoughts[0].type;
+    }
+    return contribution;
+}
+
+static void ApplyContribution(park_guest_statistics * statistics, const PeepContribution &contribution, sint32 sign)
+{
+    uint8 flags = contribution.Flags;
+    if (!(flags & PEEP_CONTRIBUTION_COUNTED))
+    {
+        return;
+    }
+
+    if (flags & PEEP_CONTRIBUTION_STAFF)
+    {
+        statistics->staff += sign;
+        if (contribution.StaffType < STAFF_TYPE_COUNT)
+        {
+            statistics->staff_of_type[contribution.StaffType] += sign;
+        }
+        return;
+    }
+
+    statistics->guests += sign;
+    if (flags & PEEP_CONTRIBUTION_IN_PARK)
+    {
+        statistics->guests_in_park += sign;
+    }
+    if (flags & PEEP_CONTRIBUTION_HAPPY)
+    {
+        statistics->happy_guests += sign;
+    }
+    if (flags & PEEP_CONTRIBUTION_LOST)
+    {
+        statistics->lost_guests += sign;
+    }
+    if (flags & PEEP_CONTRIBUTION_RECENT_THOUGHT)
+    {
+        statistics->recent_thoughts[contribution.Thought] += sign;
+    }
+}
+
+static void ScanStatistics(park_guest_statistics * statistics)
+{
+    *statistics = { 0 };
+
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_PEEPS(spriteIndex, peep)
+    {
+        ApplyContribution(statistics, GetContribution(peep), 1);
+    }
+}
+
+static void RebuildStatistics()
+{
+    _statistics = { 0 };
+    std::fill_n(_contributions, MAX_SPRITES, PeepContribution { 0, 0, 0 });
+
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_PEEPS(spriteIndex, peep)
+    {
+        _contributions[spriteIndex] = GetContribution(peep);
+        ApplyContribution(&_statistics, _contributions[spriteIndex], 1);
+    }
+    _statisticsValid = true;
+}
+
+static bool IsStatisticsEqual(const park_guest_statistics &a, const park_guest_statistics &b)
+{
+    return a.guests == b.guests &&
+        a.guests_in_park == b.guests_in_park &&
+        a.happy_guests == b.happy_guests &&
+        a.lost_guests == b.lost_guests &&
+        a.staff == b.staff &&
+        std::equal(std::begin(a.recent_thoughts), std::end(a.recent_thoughts), std::begin(b.recent_thoughts)) &&
+        std::equal(std::begin(a.staff_of_type), std::end(a.staff_of_type), std::begin(b.staff_of_type));
+}
+
+extern "C"
+{
+    void park_statistics_invalidate()
+    {
+        _statisticsValid = false;
+    }
+
+    /**
+     * Called whenever a peep is created or one of the fields counted by the statistics may have changed.
+     */
+    void park_statistics_update_peep(rct_peep * peep)
+    {
+        if (!_statisticsValid)
+        {
+            return;
+        }
+
+        uint16 spriteIndex = peep->sprite_index;
+        PeepContribution contribution = GetContribution(peep);
+        ApplyContribution(&_statistics, _contributions[spriteIndex], -1);
+        ApplyContribution(&_statistics, contribution, 1);
+        _contributions[spriteIndex] = contribution;
+    }
+
+    void park_statistics_remove_peep(rct_peep * peep)
+    {
+        if (!_statisticsValid)
+        {
+            return;
+        }
+
+        uint16 spriteIndex = peep->sprite_index;
+        ApplyContribution(&_statistics, _contributions[spriteIndex], -1);
+        _contributions[spriteIndex] = { 0, 0, 0 };
+    }
+
+    const park_guest_statistics * park_statistics_get()
+    {
+        if (!_statisticsValid)
+        {
+            RebuildStatistics();
+        }
+        else if (_verify)
+        {
+            park_guest_statistics scanned;
+            ScanStatistics(&scanned);
+            if (!IsStatisticsEqual(scanned, _statistics))
+            {
+                log_error("Guest statistics differ from a full scan: guests %u/%u, in park %u/%u, happy %u/%u, lost %u/%u, staff %u/%u",
+                    _statistics.guests, scanned.guests,
+                    _statistics.guests_in_park, scanned.guests_in_park,
+                    _statistics.happy_guests, scanned.happy_guests,
+                    _statistics.lost_guests, scanned.lost_guests,
+                    _statistics.staff, scanned.staff);
+                _mismatchCount++;
+                RebuildStatistics();
+            }
+        }
+        return &_statistics;
+    }
+
+    void park_statistics_set_verify(bool verify)
+    {
+        _verify = verify;
+    }
+
+    bool park_statistics_get_verify()
+    {
+        return _verify;
+    }
+
+    uint32 park_statistics_get_mismatch_count()
+    {
+        return _mismatchCount;
+    }
+}
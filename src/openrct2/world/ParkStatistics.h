@@ -0,0 +1,60 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _PARK_STATISTICS_H_
+#define _PARK_STATISTICS_H_
+
+#include "../common.h"
+#include "../peep/Peep.h"
+#include "../peep/Staff.h"
+
+/**
+ * Totals over all peeps that the park rating, awards and finances need. Guests report changes to
+ * the fields that are counted here, so reading the totals does not need a scan of the peep list.
+ */
+typedef struct park_guest_statistics {
+    uint32 guests;
+    uint32 guests_in_park;
+    uint32 happy_guests;
+    uint32 lost_guests;
+    // Guests in the park whose newest thought is recent, by thought type
+    uint32 recent_thoughts[256];
+    uint32 staff;
+    uint32 staff_of_type[STAFF_TYPE_COUNT];
+} park_guest_statistics;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void park_statistics_invalidate();
+void park_statistics_update_peep(rct_peep * peep);
+void park_statistics_remove_peep(rct_peep * peep);
+const park_guest_statistics * park_statistics_get();
+
+/**
+ * When verification is on every read is checked against a full scan of the peep list. Differences
+ * are logged and counted, and the scanned totals are used instead.
+ */
+void park_statistics_set_verify(bool verify);
+bool park_statistics_get_verify();
+uint32 park_statistics_get_mismatch_count();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,6 +20,7 @@
 #include "../network/network.h"
 #include "../object_list.h"
 #include "../OpenRCT2.h"
+#include "../peep/PathDistanceField.h"
 #include "../ride/station.h"
 #include "../ride/track.h"
 #include "../ride/track_data.h"
@@ -324,6 +325,7 @@ static money32 footpath_element_update(sint32 x, sint32 y, rct_map_element *mapE
 
         mapElement->properties.path.type = (mapElement->properties.path.type & 0x0F) | (type << 4);
         mapElement->type = (mapElement->type & 0xFE) | (type >> 7);
+        path_distance_field_invalidate_tile(x >> 5, y >> 5);
         footpath_element_set_path_scenery(mapElement, pathItemType);
         mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
 
@@ -1128,7 +1130,11 @@ static bool sub_footpath_disconnect_queue_from_path(sint32 x, sint32 y, rct_map_
             mapElement->properties.path.edges |= (1 << direction);
             otherMapElement->properties.path.edges |= (1 << ((direction + 2) & 3));
         }
-        if (action != 0) map_invalidate_tile_full(x1, y1);
+        if (action != 0) {
+            path_distance_field_invalidate_tile(x >> 5, y >> 5);
+            path_distance_field_invalidate_tile(x1 >> 5, y1 >> 5);
+            map_invalidate_tile_full(x1, y1);
+        }
         return true;
     }
     return false;
@@ -1337,6 +1343,7 @@ void footpath_connect_edges(sint32 x, sint32 y, rct_map_element *mapElement, sin
     rct_neighbour_list neighbourList;
     rct_neighbour neighbour;
 
+    path_distance_field_invalidate_area((x >> 5) - 1, (y >> 5) - 1, (x >> 5) + 1, (y >> 5) + 1);
     footpath_update_queue_chains();
 
     neighbour_list_init(&neighbourList);
@@ -1450,6 +1457,7 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
             mapElement->properties.path.additions &= 0x8F;
             mapElement->properties.path.additions |= (entranceIndex & 7) << 4;
 
+            path_distance_field_invalidate_tile(x >> 5, y >> 5);
             map_invalidate_element(x, y, mapElement);
 
             if (lastQueuePathElement == NULL) {
@@ -1783,6 +1791,22 @@ static void footpath_clear_wide(sint32 x, sint32 y)
     } while (!map_element_is_last_for_tile(mapElement++));
 }
 
+/**
+ * Gets the wide flags of all footpaths at the location, one bit per map element.
+ */
+static uint32 footpath_get_wide_flags(sint32 x, sint32 y)
+{
+    uint32 wideFlags = 0;
+    uint32 bit = 1;
+    rct_map_element *mapElement = map_get_first_element_at(x / 32, y / 32);
+    do {
+        if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH && footpath_element_is_wide(mapElement))
+            wideFlags |= bit;
+        bit <<= 1;
+    } while (!map_element_is_last_for_tile(mapElement++));
+    return wideFlags;
+}
+
 /**
 *
 *  rct2: 0x006A8ACF
@@ -1823,6 +1847,7 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
     if (y > 0x1FDF)
         return;
 
+    uint32 previousWideFlags = footpath_get_wide_flags(x, y);
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1996,6 +2021,10 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
                 mapElement->type |= 2;
         }
     } while (!map_element_is_last_for_tile(mapElement++));
+
+    // Guests do not path find across wide paths, so changes must rebuild any distance field using this tile
+    if (footpath_get_wide_flags(x, y) != previousWideFlags)
+        path_distance_field_invalidate_tile(x >> 5, y >> 5);
 }
 
 /**
@@ -2015,6 +2044,7 @@ void footpath_update_queue_entrance_banner(sint32 x, sint32 y, rct_map_element *
                 }
             }
             mapElement->properties.path.ride_index = 255;
+            path_distance_field_invalidate_tile(x >> 5, y >> 5);
         }
         break;
     case MAP_ELEMENT_TYPE_ENTRANCE:
@@ -2114,6 +2144,8 @@ static void footpath_remove_edges_towards(sint32 x, sint32 y, sint32 z0, sint32
  */
 void footpath_remove_edges_at(sint32 x, sint32 y, rct_map_element *mapElement)
 {
+    path_distance_field_invalidate_area((x >> 5) - 1, (y >> 5) - 1, (x >> 5) + 1, (y >> 5) + 1);
+
     if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_TRACK) {
         sint32 rideIndex = mapElement->properties.track.ride_index;
         Ride *ride = get_ride(rideIndex);
@@ -21,12 +21,14 @@
 #include "../Context.h"
 #include "../game.h"
 #include "../interface/Cursors.h"
+#include "../interface/viewport.h"
 #include "../interface/window.h"
 #include "../localisation/date.h"
 #include "../localisation/localisation.h"
 #include "../management/Finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../peep/PathDistanceField.h"
 #include "../ride/ride_data.h"
 #include "../ride/track.h"
 #include "../ride/track_data.h"
@@ -93,12 +95,16 @@ sint16 gMapSizeMaxXY;
 sint16 gMapBaseZ;
 
 #if defined(NO_RCT2)
-rct_map_element gMapElements[MAX_TILE_MAP_ELEMENT_POINTERS * 3];
+static rct_map_element _initialMapElements[MAP_ELEMENTS_INITIAL_CAPACITY];
+rct_map_element *gMapElements = _initialMapElements;
 rct_map_element *gMapElementTilePointers[MAX_TILE_MAP_ELEMENT_POINTERS];
 #else
 rct_map_element *gMapElements = RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS, rct_map_element);
 rct_map_element **gMapElementTilePointers = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_ELEMENT_POINTERS, rct_map_element*);
 #endif
+uint32 gMapElementsCapacity = MAP_ELEMENTS_INITIAL_CAPACITY;
+// The previous store is kept until the next resize so element pointers held across an insert stay readable
+static rct_map_element *_retiredMapElements = NULL;
 LocationXY16 gMapSelectionTiles[300];
 rct2_peep_spawn gPeepSpawns[MAX_PEEP_SPAWNS];
 
@@ -469,7 +475,7 @@ void map_strip_ghost_flag_from_elements()
     rct_map_element *mapElement = gMapElements;
     do {
         mapElement->flags &= ~MAP_ELEMENT_FLAG_GHOST;
-    } while (++mapElement < gMapElements + MAX_MAP_ELEMENTS);
+    } while (++mapElement < gMapElements + gMapElementsCapacity);
 }
 
 /**
@@ -494,6 +500,9 @@ void map_update_tile_pointers()
     }
 
     gNextFreeMapElement = mapElement;
+    map_compaction_reset();
+    path_distance_field_invalidate_all();
+    viewport_invalidate_pick_cache();
 }
 
 /**
@@ -643,55 +652,6 @@ sint32 map_element_height(sint32 x, sint32 y)
     return height;
 }
 
-/**
- *
- *  rct2: 0x0068B089
- */
-void sub_68B089()
-{
-    sint32 i;
-    rct_map_element *mapElementFirst, *mapElement;
-
-    if (gTrackDesignSaveMode)
-        return;
-
-    i = gNextFreeMapElementPointerIndex;
-    do {
-        i++;
-        if (i >= MAX_TILE_MAP_ELEMENT_POINTERS)
-            i = 0;
-    } while (gMapElementTilePointers[i] == TILE_UNDEFINED_MAP_ELEMENT);
-    gNextFreeMapElementPointerIndex = i;
-
-    mapElementFirst = mapElement = gMapElementTilePointers[i];
-    do {
-        mapElement--;
-        if (mapElement < gMapElements)
-            break;
-    } while (mapElement->base_height == 255);
-    mapElement++;
-
-    if (mapElement == mapElementFirst)
-        return;
-
-    //
-    gMapElementTilePointers[i] = mapElement;
-    do {
-        *mapElement = *mapElementFirst;
-        mapElementFirst->base_height = 255;
-
-        mapElementFirst++;
-    } while (!map_element_is_last_for_tile(mapElement++));
-
-    mapElement = gNextFreeMapElement;
-    do {
-        mapElement--;
-    } while (mapElement->base_height == 255);
-    mapElement++;
-    gNextFreeMapElement = mapElement;
-}
-
-
 /**
  * Checks if the tile at coordinate at height counts as connected.
  * @return 1 if connected, 0 otherwise
@@ -2937,6 +2897,8 @@ void map_element_decrement_onride_photo_timout(rct_map_element * mapElement)
  */
 void map_element_remove(rct_map_element *mapElement)
 {
+    viewport_invalidate_pick_cache();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make mapElement point to the old last element position,
     // after copy it to it's new position
@@ -2949,6 +2911,7 @@ void map_element_remove(rct_map_element *mapElement)
     // Mark the latest element with the last element flag.
     (mapElement - 1)->flags |= MAP_ELEMENT_FLAG_LAST_TILE;
     mapElement->base_height = 0xFF;
+    map_compaction_notify_removed();
 
     if ((mapElement + 1) == gNextFreeMapElement){
         gNextFreeMapElement--;
@@ -3073,35 +3036,105 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CURSOR_ZZZ);
 
-    rct_map_element* new_map_elements = malloc(3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_map_element));
-    rct_map_element* new_elements_pointer = new_map_elements;
-
+    // Only the elements in use need a scratch copy, not the whole store
+    uint32 num_elements = map_count_elements();
+    rct_map_element* new_map_elements = malloc(num_elements * sizeof(rct_map_element));
     if (new_map_elements == NULL) {
         log_fatal("Unable to allocate memory for map elements.");
         return;
     }
 
-    uint32 num_elements;
+    map_copy_elements_in_tile_order(new_map_elements, num_elements);
+    memcpy(gMapElements, new_map_elements, num_elements * sizeof(rct_map_element));
+    memset(gMapElements + num_elements, 0, (gMapElementsCapacity - num_elements) * sizeof(rct_map_element));
+
+    free(new_map_elements);
 
+    map_update_tile_pointers();
+}
+
+/**
+ * Counts the map elements in use by all tiles.
+ */
+uint32 map_count_elements()
+{
+    uint32 count = 0;
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        rct_map_element *mapElement = gMapElementTilePointers[i];
+        if (mapElement == TILE_UNDEFINED_MAP_ELEMENT)
+            continue;
+
+        do {
+            count++;
+        } while (!map_element_is_last_for_tile(mapElement++));
+    }
+    return count;
+}
+
+/**
+ * Copies the elements of every tile, one tile after another in the order the tiles are stored in
+ * a saved game, without modifying the store.
+ * @returns the number of elements copied.
+ */
+uint32 map_copy_elements_in_tile_order(rct_map_element *dst, uint32 maxElements)
+{
+    uint32 count = 0;
     for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
         for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
             rct_map_element *startElement = map_get_first_element_at(x, y);
             rct_map_element *endElement = startElement;
             while (!map_element_is_last_for_tile(endElement++));
 
-            num_elements = (uint32)(endElement - startElement);
-            memcpy(new_elements_pointer, startElement, num_elements * sizeof(rct_map_element));
-            new_elements_pointer += num_elements;
+            uint32 num_elements = (uint32)(endElement - startElement);
+            if (count + num_elements > maxElements)
+                return count;
+
+            memcpy(dst + count, startElement, num_elements * sizeof(rct_map_element));
+            count += num_elements;
         }
     }
+    return count;
+}
 
-    num_elements = (uint32)(new_elements_pointer - new_map_elements);
-    memcpy(gMapElements, new_map_elements, num_elements * sizeof(rct_map_element));
-    memset(gMapElements + num_elements, 0, (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(rct_map_element));
+/**
+ * Moves the element store to a new allocation of the given capacity. Elements keep their index
+ * within the store. The capacity can not be smaller than the initial store.
+ */
+bool map_resize_elements(uint32 capacity)
+{
+#if defined(NO_RCT2)
+    capacity = max(capacity, MAP_ELEMENTS_INITIAL_CAPACITY);
+    uint32 usedElements = (uint32)(gNextFreeMapElement - gMapElements);
+    if (capacity < usedElements + MAP_ELEMENTS_SCRATCH_SPACE)
+        return false;
 
-    free(new_map_elements);
+    rct_map_element *newMapElements = malloc(capacity * sizeof(rct_map_element));
+    if (newMapElements == NULL) {
+        log_error("Unable to allocate memory for %u map elements.", capacity);
+        return false;
+    }
 
-    map_update_tile_pointers();
+    uint32 elementsToCopy = min(capacity, gMapElementsCapacity);
+    memcpy(newMapElements, gMapElements, elementsToCopy * sizeof(rct_map_element));
+    memset(newMapElements + elementsToCopy, 0, (capacity - elementsToCopy) * sizeof(rct_map_element));
+
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        if (gMapElementTilePointers[i] != TILE_UNDEFINED_MAP_ELEMENT) {
+            gMapElementTilePointers[i] = newMapElements + (gMapElementTilePointers[i] - gMapElements);
+        }
+    }
+    gNextFreeMapElement = newMapElements + usedElements;
+
+    if (_retiredMapElements != NULL) {
+        free(_retiredMapElements);
+    }
+    _retiredMapElements = (gMapElements == _initialMapElements) ? NULL : gMapElements;
+    gMapElements = newMapElements;
+    gMapElementsCapacity = capacity;
+    return true;
+#else
+    return false;
+#endif
 }
 
 /**
@@ -3112,18 +3145,36 @@ void map_reorganise_elements()
  */
 bool map_check_free_elements_and_reorganise(sint32 num_elements)
 {
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
+    rct_map_element *storeEnd = gMapElements + gMapElementsCapacity - MAP_ELEMENTS_SCRATCH_SPACE;
+    if ((gNextFreeMapElement + num_elements) <= storeEnd)
         return true;
 
-    for (sint32 i = 1000; i != 0; --i)
-        sub_68B089();
+    // Elements are about to move, so cached picks may point at stale elements
+    viewport_invalidate_pick_cache();
+    map_compact_elements(MAP_COMPACTION_TILES_WHEN_FULL);
 
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
+    if ((gNextFreeMapElement + num_elements) <= storeEnd)
         return true;
 
-    map_reorganise_elements();
+    // Live elements are capped at what a saved game holds, the extra capacity only absorbs removed elements
+    uint32 usedElements = map_count_elements();
+    if (usedElements + num_elements > MAX_MAP_ELEMENTS) {
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+        return false;
+    }
+
+    // Grow the store rather than stalling on a full reorganisation, unless most of it is unused
+    uint32 usableCapacity = gMapElementsCapacity - MAP_ELEMENTS_SCRATCH_SPACE;
+    bool resized = false;
+    if (usedElements > usableCapacity / 2 && gMapElementsCapacity < MAP_ELEMENTS_MAXIMUM_CAPACITY) {
+        resized = map_resize_elements(min(gMapElementsCapacity + gMapElementsCapacity / 2, MAP_ELEMENTS_MAXIMUM_CAPACITY));
+    }
+    if (!resized) {
+        map_reorganise_elements();
+    }
 
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
+    storeEnd = gMapElements + gMapElementsCapacity - MAP_ELEMENTS_SCRATCH_SPACE;
+    if ((gNextFreeMapElement + num_elements) <= storeEnd)
         return true;
     else{
         gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
@@ -3144,6 +3195,9 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
         return NULL;
     }
 
+    path_distance_field_invalidate_tile(x, y);
+    viewport_invalidate_pick_cache();
+
     newMapElement = gNextFreeMapElement;
     originalMapElement = gMapElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
 
@@ -3186,6 +3240,7 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
     }
 
     gNextFreeMapElement = newMapElement;
+    map_compaction_notify_removed();
     return insertedElement;
 }
 
@@ -3197,7 +3252,7 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
 bool map_element_check_address(const rct_map_element * const element)
 {
     if (element >= gMapElements
-        && element < gMapElements + MAX_MAP_ELEMENTS
+        && element < gMapElements + gMapElementsCapacity - MAP_ELEMENTS_SCRATCH_SPACE
         // condition below checks alignment
         && gMapElements + (((uintptr_t)element - (uintptr_t)gMapElements) / sizeof(rct_map_element)) == element)
     {
@@ -3728,6 +3783,7 @@ static void clear_element_at(sint32 x, sint32 y, rct_map_element **elementPtr)
         );
         break;
     default:
+        path_distance_field_invalidate_tile(x >> 5, y >> 5);
         map_element_remove(element);
         break;
     }
@@ -3976,7 +4032,7 @@ LocationXY32 translate_3d_to_2d_with_z(sint32 rotation, LocationXYZ32 pos)
 
 static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 maxZoom)
 {
-    if (gOpenRCT2Headless) return;
+    if (gOpenRCT2Headless || gInTurboUpdate) return;
 
     sint32 x1, y1, x2, y2;
 
@@ -4271,6 +4327,11 @@ void game_command_modify_tile(sint32* eax, sint32* ebx, sint32* ecx, sint32* edx
     const sint32 y = (*ecx >> 8) & 0xFF;
     const tile_inspector_instruction instruction = *eax;
 
+    if (flags & GAME_COMMAND_FLAG_APPLY)
+    {
+        path_distance_field_invalidate_tile(x, y);
+    }
+
     switch (instruction)
     {
     case TILE_INSPECTOR_ANY_REMOVE:
@@ -284,8 +284,17 @@ enum
 
 #define MAP_MINIMUM_X_Y -MAXIMUM_MAP_SIZE_TECHNICAL
 
-#define MAX_MAP_ELEMENTS 196096 // 0x30000
+// Maximum number of map elements in use at once, limited by what fits in a saved game
+#define MAX_MAP_ELEMENTS 196096 // 0x2FE00
 #define MAX_TILE_MAP_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
+// The element store starts with room for a whole saved game and grows when removed elements fragment it
+#define MAP_ELEMENTS_INITIAL_CAPACITY (MAX_TILE_MAP_ELEMENT_POINTERS * 3)
+#define MAP_ELEMENTS_MAXIMUM_CAPACITY (MAP_ELEMENTS_INITIAL_CAPACITY * 4)
+// Space kept free at the end of the store for copying a tile's elements when inserting
+#define MAP_ELEMENTS_SCRATCH_SPACE (MAP_ELEMENTS_INITIAL_CAPACITY - MAX_MAP_ELEMENTS)
+// Number of tiles the compactor relocates each game tick, and when the store runs out of space
+#define MAP_COMPACTION_TILES_PER_TICK 256
+#define MAP_COMPACTION_TILES_WHEN_FULL 1024
 #define MAX_PEEP_SPAWNS 2
 #define PEEP_SPAWN_UNDEFINED 0xFFFF
 
@@ -335,6 +344,18 @@ enum {
     MAP_SELECT_TYPE_EDGE_3,
 };
 
+typedef struct map_element_store_stats {
+    uint32 capacity;
+    uint32 used;            // Elements up to gNextFreeMapElement, live or removed
+    uint32 live;
+    uint32 removed;
+    uint32 gaps;            // Runs of removed elements
+    uint32 largest_gap;
+    uint32 sweeps;          // Completed compaction passes over the store
+    uint32 tiles_moved;
+    bool compacting;
+} map_element_store_stats;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -361,11 +382,11 @@ extern uint8        gMapSelectArrowDirection;
 
 extern uint8 gMapGroundFlags;
 
+extern rct_map_element *gMapElements;
+extern uint32 gMapElementsCapacity;
 #ifdef NO_RCT2
-extern rct_map_element gMapElements[];
 extern rct_map_element *gMapElementTilePointers[];
 #else
-extern rct_map_element *gMapElements;
 extern rct_map_element **gMapElementTilePointers;
 #endif
 
@@ -416,7 +437,6 @@ rct_map_element *map_get_wall_element_at(sint32 x, sint32 y, sint32 z, sint32 di
 rct_map_element *map_get_small_scenery_element_at(sint32 x, sint32 y, sint32 z, sint32 type, uint8 quadrant);
 rct_map_element *map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost);
 sint32 map_element_height(sint32 x, sint32 y);
-void sub_68B089();
 sint32 map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection);
 void map_remove_provisional_elements();
 void map_restore_provisional_elements();
@@ -444,6 +464,13 @@ void map_invalidate_map_selection_tiles();
 void map_invalidate_selection_rect();
 void map_reorganise_elements();
 bool map_check_free_elements_and_reorganise(sint32 num_elements);
+uint32 map_count_elements();
+uint32 map_copy_elements_in_tile_order(rct_map_element *dst, uint32 maxElements);
+bool map_resize_elements(uint32 capacity);
+void map_compact_elements(sint32 maxTiles);
+void map_compaction_notify_removed();
+void map_compaction_reset();
+void map_get_element_store_stats(map_element_store_stats * stats);
 rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags);
 bool map_element_check_address(const rct_map_element * const element);
 
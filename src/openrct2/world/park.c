@@ -34,6 +34,8 @@
 #include "../scenario/scenario.h"
 #include "../world/map.h"
 #include "entrance.h"
+#include "LitterSpatialIndex.h"
+#include "ParkStatistics.h"
 #include "park.h"
 #include "sprite.h"
 
@@ -180,6 +182,12 @@ sint32 park_calculate_size()
     return tiles;
 }
 
+static bool park_rating_litter_filter(const rct_litter *litter, const void *context)
+{
+    // Ignore recently dropped litter
+    return litter->creationTick - gScenarioTicks >= 7680;
+}
+
 /**
  *
  *  rct2: 0x00669EAA
@@ -197,25 +205,14 @@ sint32 calculate_park_rating()
 
     // Guests
     {
-        rct_peep* peep;
-        uint16 spriteIndex;
-        sint32 num_happy_peeps;
-        sint32 num_lost_guests;
+        const park_guest_statistics *statistics = park_statistics_get();
 
         // -150 to +3 based on a range of guests from 0 to 2000
         result -= 150 - (min(2000, gNumGuestsInPark) / 13);
 
-        // Find the number of happy peeps and the number of peeps who can't find the park exit
-        num_happy_peeps = 0;
-        num_lost_guests = 0;
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (peep->happiness > 128)
-                num_happy_peeps++;
-            if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
-                num_lost_guests++;
-        }
+        // The number of happy peeps and the number of peeps who can't find the park exit
+        sint32 num_happy_peeps = (sint32)statistics->happy_guests;
+        sint32 num_lost_guests = (sint32)statistics->lost_guests;
 
         // Peep happiness -500 to +0
         result -= 500;
@@ -278,18 +275,8 @@ sint32 calculate_park_rating()
 
     // Litter
     {
-        rct_litter* litter;
-        uint16 sprite_idx;
-        sint16 num_litter;
-
-        num_litter = 0;
-        for (sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next) {
-            litter = &(get_sprite(sprite_idx)->litter);
-
-            // Ignore recently dropped litter
-            if (litter->creationTick - gScenarioTicks >= 7680)
-                num_litter++;
-        }
+        // Only the first 150 pieces of litter affect the rating
+        sint32 num_litter = litter_spatial_index_count(0, 0, (MAXIMUM_MAP_SIZE_TECHNICAL * 32) - 1, (MAXIMUM_MAP_SIZE_TECHNICAL * 32) - 1, park_rating_litter_filter, NULL, 150);
         result -= 600 - (4 * (150 - min(150, num_litter)));
     }
 
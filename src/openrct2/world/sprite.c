@@ -21,9 +21,12 @@
 #include "../localisation/date.h"
 #include "../localisation/localisation.h"
 #include "../OpenRCT2.h"
+#include "../peep/PeepSpatialIndex.h"
 #include "../rct2/addresses.h"
 #include "../scenario/scenario.h"
 #include "Fountain.h"
+#include "LitterSpatialIndex.h"
+#include "ParkStatistics.h"
 #include "sprite.h"
 
 #ifdef NO_RCT2
@@ -72,6 +75,7 @@ uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y)
 static void invalidate_sprite_max_zoom(rct_sprite *sprite, sint32 maxZoom)
 {
     if (sprite->unknown.sprite_left == LOCATION_NULL) return;
+    if (gInTurboUpdate) return;
 
     for (sint32 i = 0; i < MAX_VIEWPORT_COUNT; i++) {
         rct_viewport *viewport = &g_viewport_list[i];
@@ -176,6 +180,9 @@ void reset_sprite_spatial_index()
             spr->unknown.next_in_quadrant = nextSpriteId;
         }
     }
+    peep_spatial_index_invalidate();
+    litter_spatial_index_invalidate();
+    park_statistics_invalidate();
 }
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
@@ -573,6 +580,12 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
     } else {
         sprite_set_coordinates(x, y, z, sprite);
     }
+
+    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        peep_spatial_index_update(&sprite->peep);
+    } else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER) {
+        litter_spatial_index_update(&sprite->litter);
+    }
 }
 
 void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
@@ -611,6 +624,12 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        peep_spatial_index_remove(&sprite->peep);
+        park_statistics_remove_peep(&sprite->peep);
+    } else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER) {
+        litter_spatial_index_remove(&sprite->litter);
+    }
     move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
     user_string_free(sprite->unknown.name_string_idx);
     sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
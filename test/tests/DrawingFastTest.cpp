@@ -0,0 +1,290 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "openrct2/drawing/drawing.h"
+
+#include <gtest/gtest.h>
+
+// Draws random RLE sprites with gfx_rle_sprite_to_buffer, which uses the SSE2 copy and AVX2 remap / blend kernels
+// where the CPU has them, and checks the surface against a copy of the original scalar implementation.
+
+namespace Reference
+{
+    template<sint32 image_type, sint32 zoom_level>
+    static void DrawRLESprite(const uint8 * source_bits_pointer,
+                              uint8 * dest_bits_pointer,
+                              const uint8 * palette_pointer,
+                              const rct_drawpixelinfo * dpi,
+                              sint32 source_y_start,
+                              sint32 height,
+                              sint32 source_x_start,
+                              sint32 width)
+    {
+        sint32 zoom_amount = 1 << zoom_level;
+        sint32 line_width = (dpi->width >> zoom_level) + dpi->pitch;
+
+        if (source_y_start < 0)
+        {
+            source_y_start    += zoom_amount;
+            height            -= zoom_amount;
+            dest_bits_pointer += line_width;
+        }
+
+        for (sint32 i = 0; i < height; i += zoom_amount)
+        {
+            sint32 y = source_y_start + i;
+            const uint8 * lineData = source_bits_pointer + ((uint16 *)source_bits_pointer)[y];
+            uint8 * loop_dest_pointer = dest_bits_pointer + line_width * (i >> zoom_level);
+
+            uint8 isEndOfLine = 0;
+            while (!isEndOfLine)
+            {
+                const uint8 * copySrc = lineData;
+
+                uint8 dataSize    = *copySrc++;
+                uint8 firstPixelX = *copySrc++;
+
+                isEndOfLine = dataSize & 0x80;
+                dataSize &= 0x7F;
+
+                lineData = copySrc + dataSize;
+
+                sint32 x_start = firstPixelX - source_x_start;
+                sint32 numPixels = dataSize;
+
+                if (x_start > 0)
+                {
+                    int mod = x_start & (zoom_amount - 1);
+                    if (mod != 0)
+                    {
+                        int offset = zoom_amount - mod;
+                        x_start   += offset;
+                        copySrc   += offset;
+                        numPixels -= offset;
+                    }
+                }
+                else if (x_start < 0)
+                {
+                    int offset = 0 - x_start;
+                    x_start = 0;
+                    copySrc   += offset;
+                    numPixels -= offset;
+                }
+
+                if (x_start + numPixels > width)
+                    numPixels = width - x_start;
+
+                uint8 * copyDest = loop_dest_pointer + (x_start >> zoom_level);
+
+                if (image_type & IMAGE_TYPE_REMAP)
+                {
+                    for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
+                    {
+                        if (image_type & IMAGE_TYPE_TRANSPARENT)
+                        {
+                            uint16 color = ((*copySrc << 8) | *copyDest) - 0x100;
+                            *copyDest = palette_pointer[color];
+                        }
+                        else
+                        {
+                            *copyDest = palette_pointer[*copySrc];
+                        }
+                    }
+                }
+                else if (image_type & IMAGE_TYPE_TRANSPARENT)
+                {
+                    for (int j = 0; j < numPixels; j += zoom_amount, copyDest++)
+                    {
+                        *copyDest = palette_pointer[*copyDest];
+                    }
+                }
+                else
+                {
+                    if (zoom_level == 0)
+                    {
+                        if (numPixels > 0)
+                            memcpy(copyDest, copySrc, numPixels);
+                    }
+                    else
+                    {
+                        for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
+                            *copyDest = *copySrc;
+                    }
+                }
+            }
+        }
+    }
+
+    template<sint32 image_type>
+    static void DrawRLESprite(const uint8 * source_bits_pointer,
+                              uint8 * dest_bits_pointer,
+                              const uint8 * palette_pointer,
+                              const rct_drawpixelinfo * dpi,
+                              sint32 source_y_start,
+                              sint32 height,
+                              sint32 source_x_start,
+                              sint32 width)
+    {
+        switch (dpi->zoom_level) {
+        case 0: DrawRLESprite<image_type, 0>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width); break;
+        case 1: DrawRLESprite<image_type, 1>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width); break;
+        case 2: DrawRLESprite<image_type, 2>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width); break;
+        case 3: DrawRLESprite<image_type, 3>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width); break;
+        }
+    }
+
+    static void rle_sprite_to_buffer(const uint8 * source_bits_pointer,
+                                     uint8 * dest_bits_pointer,
+                                     const uint8 * palette_pointer,
+                                     const rct_drawpixelinfo * dpi,
+                                     sint32 image_type,
+                                     sint32 source_y_start,
+                                     sint32 height,
+                                     sint32 source_x_start,
+                                     sint32 width)
+    {
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            if (image_type & IMAGE_TYPE_TRANSPARENT)
+            {
+                DrawRLESprite<IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width);
+            }
+            else
+            {
+                DrawRLESprite<IMAGE_TYPE_REMAP>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width);
+            }
+        }
+        else if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            DrawRLESprite<IMAGE_TYPE_TRANSPARENT>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width);
+        }
+        else
+        {
+            DrawRLESprite<IMAGE_TYPE_DEFAULT>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width);
+        }
+    }
+}
+
+class DrawingFastTest : public testing::TestWithParam<sint32>
+{
+protected:
+    static const sint32 SPRITES = 200;
+    static const sint32 MAX_HEIGHT = 48;
+    // Room either side of the surface so that a stray write shows up as a difference
+    static const sint32 GUARD_SIZE = 64;
+
+    std::mt19937 _rng { 1234 };
+    std::vector<uint8> _palette;
+
+    void SetUp() override
+    {
+        // The remap + transparent blend looks up (source << 8 | surface) - 0x100, so fill a full 64 KiB table
+        _palette.resize(0x10000);
+        for (auto &b : _palette)
+        {
+            b = (uint8)_rng();
+        }
+    }
+
+    sint32 Random(sint32 lo, sint32 hi)
+    {
+        return std::uniform_int_distribution<sint32>(lo, hi)(_rng);
+    }
+
+    // Builds a sprite of height lines, each made of runs of up to 127 pixels at random positions
+    std::vector<uint8> CreateSprite(sint32 height)
+    {
+        std::vector<uint8> sprite(height * 2);
+        for (sint32 y = 0; y < height; y++)
+        {
+            uint16 offset = (uint16)sprite.size();
+            memcpy(&sprite[y * 2], &offset, sizeof(offset));
+
+            sint32 x = Random(0, 40);
+            bool endOfLine = false;
+            while (!endOfLine)
+            {
+                // Mostly long runs so that the kernels get used, with some short ones for the scalar fallback
+                sint32 length = Random(0, 3) == 0 ? Random(0, 15) : Random(16, 127);
+                if (x + length > 255 + 127 || x > 255)
+                {
+                    length = 0;
+                    x = 255;
+                }
+                endOfLine = x + length >= 255 || Random(0, 3) == 0;
+
+                sprite.push_back((uint8)(length | (endOfLine ? 0x80 : 0)));
+                sprite.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    sprite.push_back((uint8)_rng());
+                }
+                x += length + Random(0, 24);
+            }
+        }
+        return sprite;
+    }
+
+    void DrawAndCompare(sint32 imageType, sint32 zoomLevel)
+    {
+        for (sint32 n = 0; n < SPRITES; n++)
+        {
+            sint32 spriteHeight = Random(1, MAX_HEIGHT);
+            std::vector<uint8> sprite = CreateSprite(spriteHeight);
+
+            sint32 sourceXStart = Random(0, 48);
+            sint32 sourceYStart = Random(0, spriteHeight - 1);
+            sint32 width = Random(1, 320);
+            sint32 height = spriteHeight - sourceYStart;
+
+            rct_drawpixelinfo dpi = { };
+            dpi.width = (sint16)width;
+            dpi.height = (sint16)height;
+            dpi.pitch = (sint16)Random(0, 31);
+            dpi.zoom_level = (uint16)zoomLevel;
+
+            // Start the surface at a random alignment
+            sint32 lineWidth = (width >> zoomLevel) + dpi.pitch;
+            sint32 surfaceSize = lineWidth * ((height >> zoomLevel) + 1) + 1;
+            sint32 alignment = Random(0, 31);
+            std::vector<uint8> expected(GUARD_SIZE + alignment + surfaceSize + GUARD_SIZE);
+            for (auto &b : expected)
+            {
+                b = (uint8)_rng();
+            }
+            std::vector<uint8> actual = expected;
+            dpi.bits = actual.data() + GUARD_SIZE + alignment;
+
+            Reference::rle_sprite_to_buffer(sprite.data(), expected.data() + GUARD_SIZE + alignment, _palette.data(), &dpi,
+                                            imageType, sourceYStart, height, sourceXStart, width);
+            gfx_rle_sprite_to_buffer(sprite.data(), actual.data() + GUARD_SIZE + alignment, _palette.data(), &dpi,
+                                     imageType, sourceYStart, height, sourceXStart, width);
+
+            ASSERT_EQ(expected, actual) << "sprite " << n << ", zoom " << zoomLevel << ", width " << width
+                                        << ", source x " << sourceXStart << ", alignment " << alignment;
+        }
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(ZoomLevels, DrawingFastTest, testing::Values(0, 1, 2, 3));
+
+TEST_P(DrawingFastTest, copy)
+{
+    DrawAndCompare(IMAGE_TYPE_DEFAULT, GetParam());
+}
+
+TEST_P(DrawingFastTest, remap)
+{
+    DrawAndCompare(IMAGE_TYPE_REMAP, GetParam());
+}
+
+TEST_P(DrawingFastTest, blend)
+{
+    DrawAndCompare(IMAGE_TYPE_TRANSPARENT, GetParam());
+}
+
+TEST_P(DrawingFastTest, remap_blend)
+{
+    DrawAndCompare(IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, GetParam());
+}
@@ -0,0 +1,192 @@
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "openrct2/world/LitterSpatialIndex.h"
+#include "openrct2/world/sprite.h"
+
+#include <gtest/gtest.h>
+
+// Inserts, moves and removes litter and checks the spatial index against a search of the litter sprite list.
+
+class LitterSpatialIndexTest : public testing::Test
+{
+protected:
+    static const sint32 MAP_SIZE = MAXIMUM_MAP_SIZE_TECHNICAL * 32;
+
+    std::mt19937 _rng { 1234 };
+    std::vector<uint16> _litterSprites;
+
+    void SetUp() override
+    {
+        reset_sprite_list();
+    }
+
+    sint32 Random(sint32 lo, sint32 hi)
+    {
+        return std::uniform_int_distribution<sint32>(lo, hi)(_rng);
+    }
+
+    rct_litter * GetLitter(uint16 spriteIndex)
+    {
+        return &get_sprite(spriteIndex)->litter;
+    }
+
+    // Creates litter the same way as litter_create, without needing a footpath to put it on
+    void InsertLitter(sint16 x, sint16 y, sint16 z)
+    {
+        rct_litter * litter = (rct_litter *)create_sprite(1);
+        ASSERT_NE(litter, nullptr);
+        move_sprite_to_list((rct_sprite *)litter, SPRITE_LIST_LITTER * 2);
+        litter->sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+        sprite_move(x, y, z, (rct_sprite *)litter);
+        _litterSprites.push_back(litter->sprite_index);
+    }
+
+    void MoveLitter(uint16 spriteIndex, sint16 x, sint16 y, sint16 z)
+    {
+        sprite_move(x, y, z, get_sprite(spriteIndex));
+    }
+
+    void RemoveLitter(size_t litterIndex)
+    {
+        uint16 spriteIndex = _litterSprites[litterIndex];
+        _litterSprites.erase(_litterSprites.begin() + litterIndex);
+        sprite_remove(get_sprite(spriteIndex));
+    }
+
+    void RandomPosition(sint16 * x, sint16 * y, sint16 * z)
+    {
+        // Cluster most litter so that tiles hold more than one piece
+        if (Random(0, 3) == 0)
+        {
+            *x = (sint16)Random(0, MAP_SIZE - 1);
+            *y = (sint16)Random(0, MAP_SIZE - 1);
+        }
+        else
+        {
+            *x = (sint16)Random(64 * 32, 72 * 32 - 1);
+            *y = (sint16)Random(64 * 32, 72 * 32 - 1);
+        }
+        *z = (sint16)Random(0, 255) * 8;
+    }
+
+    sint32 BruteForceCount(sint32 left, sint32 top, sint32 right, sint32 bottom, sint32 maxCount)
+    {
+        sint32 count = 0;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            rct_litter * litter = GetLitter(spriteIndex);
+            if (litter->x >= left && litter->x <= right && litter->y >= top && litter->y <= bottom && count < maxCount)
+            {
+                count++;
+            }
+            spriteIndex = litter->next;
+        }
+        return count;
+    }
+
+    rct_litter * BruteForceNearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance)
+    {
+        rct_litter * nearestLitter = nullptr;
+        sint32 nearestDistance = maxDistance + 1;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            rct_litter * litter = GetLitter(spriteIndex);
+            sint32 distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                nearestLitter = litter;
+            }
+            spriteIndex = litter->next;
+        }
+        return nearestLitter;
+    }
+
+    void CheckAreas()
+    {
+        for (sint32 i = 0; i < 20; i++)
+        {
+            sint32 left, top, right, bottom;
+            if (i == 0)
+            {
+                // The whole map, which is counted from the sprite list
+                left = 0;
+                top = 0;
+                right = MAP_SIZE - 1;
+                bottom = MAP_SIZE - 1;
+            }
+            else
+            {
+                sint16 x, y, z;
+                RandomPosition(&x, &y, &z);
+                left = x - Random(0, 160);
+                top = y - Random(0, 160);
+                right = x + Random(0, 160);
+                bottom = y + Random(0, 160);
+            }
+            sint32 maxCount = Random(0, 1) == 0 ? INT32_MAX : Random(1, 8);
+            ASSERT_EQ(BruteForceCount(left, top, right, bottom, maxCount),
+                      litter_spatial_index_count(left, top, right, bottom, nullptr, nullptr, maxCount))
+                << "area " << left << "," << top << " to " << right << "," << bottom;
+
+            sint16 x, y, z;
+            RandomPosition(&x, &y, &z);
+            sint32 maxDistance = Random(0, 256);
+            ASSERT_EQ(BruteForceNearest(x, y, z, maxDistance), litter_spatial_index_find_nearest(x, y, z, maxDistance));
+        }
+    }
+};
+
+TEST_F(LitterSpatialIndexTest, insert_move_remove)
+{
+    for (sint32 step = 0; step < 2000; step++)
+    {
+        sint32 action = Random(0, 9);
+        if (_litterSprites.empty() || action < 5)
+        {
+            sint16 x, y, z;
+            RandomPosition(&x, &y, &z);
+            InsertLitter(x, y, z);
+        }
+        else if (action < 8)
+        {
+            sint16 x, y, z;
+            RandomPosition(&x, &y, &z);
+            MoveLitter(_litterSprites[Random(0, (sint32)_litterSprites.size() - 1)], x, y, z);
+        }
+        else
+        {
+            RemoveLitter(Random(0, (sint32)_litterSprites.size() - 1));
+        }
+
+        if (step % 50 == 0)
+        {
+            CheckAreas();
+        }
+    }
+    CheckAreas();
+}
+
+TEST_F(LitterSpatialIndexTest, rebuild_after_invalidate)
+{
+    for (sint32 i = 0; i < 500; i++)
+    {
+        sint16 x, y, z;
+        RandomPosition(&x, &y, &z);
+        InsertLitter(x, y, z);
+    }
+    CheckAreas();
+
+    // Litter moved while the index is invalid is picked up when it is rebuilt
+    litter_spatial_index_invalidate();
+    for (uint16 spriteIndex : _litterSprites)
+    {
+        sint16 x, y, z;
+        RandomPosition(&x, &y, &z);
+        MoveLitter(spriteIndex, x, y, z);
+    }
+    CheckAreas();
+}
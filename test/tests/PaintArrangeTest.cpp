@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "openrct2/interface/viewport.h"
+#include "openrct2/paint/paint.h"
+
+#include <gtest/gtest.h>
+
+// Arranges random paint struct lists and checks the order and quadrant flags against a copy of the original linked
+// list insertion sort.
+
+namespace Reference
+{
+    static bool is_bbox_intersecting(uint8 rotation, const paint_struct_bound_box& initialBBox, const paint_struct_bound_box& currentBBox)
+    {
+        bool result = false;
+        switch (rotation) {
+        case 0:
+            if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end >= currentBBox.x
+                && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x < currentBBox.x_end))
+                result = true;
+            break;
+        case 1:
+            if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end < currentBBox.x
+                && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
+                result = true;
+            break;
+        case 2:
+            if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end < currentBBox.x
+                && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
+                result = true;
+            break;
+        case 3:
+            if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end >= currentBBox.x
+                && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x < currentBBox.x_end))
+                result = true;
+            break;
+        }
+        return result;
+    }
+
+    static paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+    {
+        paint_struct * ps;
+        paint_struct * ps_temp;
+        do
+        {
+            ps = ps_next;
+            ps_next = ps_next->next_quadrant_ps;
+            if (ps_next == NULL) return ps;
+        } while (quadrantIndex > ps_next->quadrant_index);
+
+        paint_struct * ps_cache = ps;
+
+        ps_temp = ps;
+        do {
+            ps = ps->next_quadrant_ps;
+            if (ps == NULL) break;
+
+            if (ps->quadrant_index > quadrantIndex + 1)
+            {
+                ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+            }
+            else if (ps->quadrant_index == quadrantIndex + 1)
+            {
+                ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
+            else if (ps->quadrant_index == quadrantIndex)
+            {
+                ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
+        } while (ps->quadrant_index <= quadrantIndex + 1);
+        ps = ps_temp;
+
+        uint8 rotation = get_current_rotation();
+        while (true)
+        {
+            while (true)
+            {
+                ps_next = ps->next_quadrant_ps;
+                if (ps_next == NULL) return ps_cache;
+                if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) return ps_cache;
+                if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL) break;
+                ps = ps_next;
+            }
+
+            ps_next->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+            ps_temp = ps;
+
+            const paint_struct_bound_box initialBBox =
+            {
+                ps_next->bound_box_x,
+                ps_next->bound_box_y,
+                ps_next->bound_box_z,
+                ps_next->bound_box_x_end,
+                ps_next->bound_box_y_end,
+                ps_next->bound_box_z_end
+            };
+
+            while (true)
+            {
+                ps = ps_next;
+                ps_next = ps_next->next_quadrant_ps;
+                if (ps_next == NULL) break;
+                if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) break;
+                if (!(ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_NEXT)) continue;
+
+                const paint_struct_bound_box currentBBox =
+                {
+                    ps_next->bound_box_x,
+                    ps_next->bound_box_y,
+                    ps_next->bound_box_z,
+                    ps_next->bound_box_x_end,
+                    ps_next->bound_box_y_end,
+                    ps_next->bound_box_z_end
+                };
+
+                if (is_bbox_intersecting(rotation, initialBBox, currentBBox))
+                {
+                    ps->next_quadrant_ps = ps_next->next_quadrant_ps;
+                    paint_struct *ps_temp2 = ps_temp->next_quadrant_ps;
+                    ps_temp->next_quadrant_ps = ps_next;
+                    ps_next->next_quadrant_ps = ps_temp2;
+                    ps_next = ps;
+                }
+            }
+
+            ps = ps_temp;
+        }
+    }
+}
+
+using paint_arrange_function = paint_struct * (*)(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag);
+
+class PaintArrangeTest : public testing::TestWithParam<sint32>
+{
+protected:
+    static const sint32 LISTS = 300;
+    static const sint32 MAX_STRUCTS = 400;
+
+    std::mt19937 _rng { 1234 };
+
+    sint32 Random(sint32 lo, sint32 hi)
+    {
+        return std::uniform_int_distribution<sint32>(lo, hi)(_rng);
+    }
+
+    // Structs are created in quadrant order, as paint_session_arrange links the quadrants together
+    std::vector<paint_struct> CreateStructs(uint16 backIndex, uint16 frontIndex)
+    {
+        std::vector<paint_struct> structs(Random(0, MAX_STRUCTS));
+        uint16 quadrantIndex = backIndex;
+        for (auto &ps : structs)
+        {
+            memset(&ps, 0, sizeof(ps));
+            if (quadrantIndex < frontIndex && Random(0, 7) == 0)
+            {
+                quadrantIndex += (uint16)Random(1, 2);
+                quadrantIndex = std::min(quadrantIndex, frontIndex);
+            }
+            ps.quadrant_index = quadrantIndex;
+            ps.quadrant_flags = (uint8)Random(0, 0xFF);
+
+            // Keep the boxes close together so that plenty of them intersect
+            ps.bound_box_x = (uint16)Random(0, 96);
+            ps.bound_box_y = (uint16)Random(0, 96);
+            ps.bound_box_z = (uint16)Random(0, 64);
+            ps.bound_box_x_end = ps.bound_box_x + (uint16)Random(0, 32);
+            ps.bound_box_y_end = ps.bound_box_y + (uint16)Random(0, 32);
+            ps.bound_box_z_end = ps.bound_box_z + (uint16)Random(0, 32);
+        }
+        return structs;
+    }
+
+    // Same steps as paint_session_arrange, with the helper to test
+    static void Arrange(std::vector<paint_struct> &structs, paint_struct &psHead, uint16 backIndex, uint16 frontIndex,
+                        paint_arrange_function arrange)
+    {
+        memset(&psHead, 0, sizeof(psHead));
+        paint_struct * ps = &psHead;
+        for (auto &current : structs)
+        {
+            ps->next_quadrant_ps = &current;
+            ps = &current;
+        }
+        ps->next_quadrant_ps = nullptr;
+
+        paint_struct * ps_cache = arrange(&psHead, backIndex, PAINT_QUADRANT_FLAG_NEXT);
+        for (uint32 quadrantIndex = backIndex + 1; quadrantIndex < frontIndex; quadrantIndex++)
+        {
+            ps_cache = arrange(ps_cache, quadrantIndex, 0);
+        }
+    }
+
+    static std::vector<size_t> GetOrder(const std::vector<paint_struct> &structs, const paint_struct &psHead)
+    {
+        std::vector<size_t> order;
+        for (const paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            order.push_back(ps - structs.data());
+        }
+        return order;
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(Rotations, PaintArrangeTest, testing::Values(0, 1, 2, 3));
+
+TEST_P(PaintArrangeTest, matches_reference)
+{
+    gCurrentRotation = (uint8)GetParam();
+    for (sint32 n = 0; n < LISTS; n++)
+    {
+        uint16 backIndex = (uint16)Random(0, 100);
+        uint16 frontIndex = backIndex + (uint16)Random(0, 40);
+        std::vector<paint_struct> expected = CreateStructs(backIndex, frontIndex);
+        std::vector<paint_struct> actual = expected;
+
+        paint_struct expectedHead, actualHead;
+        Arrange(expected, expectedHead, backIndex, frontIndex, Reference::paint_arrange_structs_helper);
+        Arrange(actual, actualHead, backIndex, frontIndex, paint_arrange_structs_helper);
+
+        ASSERT_EQ(GetOrder(expected, expectedHead), GetOrder(actual, actualHead)) << "list " << n;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(expected[i].quadrant_flags, actual[i].quadrant_flags) << "list " << n << ", struct " << i;
+        }
+    }
+}
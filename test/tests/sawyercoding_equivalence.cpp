@@ -0,0 +1,403 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "openrct2/util/sawyercoding.h"
+
+#include <gtest/gtest.h>
+
+// Checks that the sawyer chunk codec produces exactly the same output as a copy of the original byte at a time
+// implementation. The disabled benchmark times both on a saved game sized chunk, run it with
+// --gtest_also_run_disabled_tests.
+
+namespace Reference
+{
+    static uint32 calculate_checksum(const uint8 * buffer, size_t length)
+    {
+        uint32 checksum = 0;
+        for (size_t i = 0; i < length; i++)
+            checksum += buffer[i];
+        return checksum;
+    }
+
+    static size_t decode_chunk_rle_with_size(const uint8 * src_buffer, uint8 * dst_buffer, size_t length)
+    {
+        uint8 * dst = dst_buffer;
+        for (size_t i = 0; i < length; i++)
+        {
+            uint8 rleCodeByte = src_buffer[i];
+            if (rleCodeByte & 128)
+            {
+                i++;
+                size_t count = 257 - rleCodeByte;
+                memset(dst, src_buffer[i], count);
+                dst += count;
+            }
+            else
+            {
+                memcpy(dst, src_buffer + i + 1, rleCodeByte + 1);
+                dst += rleCodeByte + 1;
+                i += rleCodeByte + 1;
+            }
+        }
+        return dst - dst_buffer;
+    }
+
+    static size_t decode_chunk_repeat(uint8 * buffer, size_t length)
+    {
+        uint8 * src = (uint8 *)malloc(length);
+        memcpy(src, buffer, length);
+        uint8 * dst = buffer;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (src[i] == 0xFF)
+            {
+                *dst++ = src[++i];
+            }
+            else
+            {
+                size_t count = (src[i] & 7) + 1;
+                uint8 * copyOffset = dst + (sint32)(src[i] >> 3) - 32;
+                memcpy(dst, copyOffset, count);
+                dst += count;
+            }
+        }
+        free(src);
+        return dst - buffer;
+    }
+
+    static void decode_chunk_rotate(uint8 * buffer, size_t length)
+    {
+        uint8 code = 1;
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer[i] = ror8(buffer[i], code);
+            code = (code + 2) % 8;
+        }
+    }
+
+    static size_t encode_chunk_rle(const uint8 * src_buffer, uint8 * dst_buffer, size_t length)
+    {
+        const uint8 * src = src_buffer;
+        uint8 * dst = dst_buffer;
+        const uint8 * end_src = src + length;
+        uint8 count = 0;
+        const uint8 * src_norm_start = src;
+
+        while (src < end_src - 1)
+        {
+            if ((count && *src == src[1]) || count > 125)
+            {
+                *dst++ = count - 1;
+                memcpy(dst, src_norm_start, count);
+                dst += count;
+                src_norm_start += count;
+                count = 0;
+            }
+            if (*src == src[1])
+            {
+                for (; (count < 125) && ((src + count) < end_src); count++)
+                {
+                    if (*src != src[count]) break;
+                }
+                *dst++ = 257 - count;
+                *dst++ = *src;
+                src += count;
+                src_norm_start = src;
+                count = 0;
+            }
+            else
+            {
+                count++;
+                src++;
+            }
+        }
+        if (src == end_src - 1) count++;
+        if (count)
+        {
+            *dst++ = count - 1;
+            memcpy(dst, src_norm_start, count);
+            dst += count;
+        }
+        return dst - dst_buffer;
+    }
+
+    static size_t encode_chunk_repeat(const uint8 * src_buffer, uint8 * dst_buffer, size_t length)
+    {
+        size_t outLength = 0;
+        *dst_buffer++ = 255;
+        *dst_buffer++ = src_buffer[0];
+        outLength += 2;
+
+        for (size_t i = 1; i < length; )
+        {
+            size_t searchIndex = (i < 32) ? 0 : (i - 32);
+            size_t searchEnd = i - 1;
+
+            size_t bestRepeatIndex = 0;
+            size_t bestRepeatCount = 0;
+            for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
+            {
+                size_t repeatCount = 0;
+                size_t maxRepeatCount = std::min<size_t>(std::min<size_t>(7, searchEnd - repeatIndex), length - i - 1);
+                for (size_t j = 0; j <= maxRepeatCount; j++)
+                {
+                    if (src_buffer[repeatIndex + j] == src_buffer[i + j])
+                    {
+                        repeatCount++;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                if (repeatCount > bestRepeatCount)
+                {
+                    bestRepeatIndex = repeatIndex;
+                    bestRepeatCount = repeatCount;
+                    if (repeatCount == 8)
+                        break;
+                }
+            }
+
+            if (bestRepeatCount == 0)
+            {
+                *dst_buffer++ = 255;
+                *dst_buffer++ = src_buffer[i];
+                outLength += 2;
+                i++;
+            }
+            else
+            {
+                *dst_buffer++ = (uint8)((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
+                outLength++;
+                i += bestRepeatCount;
+            }
+        }
+        return outLength;
+    }
+
+    static void encode_chunk_rotate(uint8 * buffer, size_t length)
+    {
+        uint8 code = 1;
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer[i] = rol8(buffer[i], code);
+            code = (code + 2) % 8;
+        }
+    }
+
+    static size_t read_chunk_buffer(uint8 * dst_buffer, const uint8 * src_buffer, sawyercoding_chunk_header chunkHeader)
+    {
+        switch (chunkHeader.encoding) {
+        case CHUNK_ENCODING_RLECOMPRESSED:
+            chunkHeader.length = (uint32)decode_chunk_rle_with_size(src_buffer, dst_buffer, chunkHeader.length);
+            chunkHeader.length = (uint32)decode_chunk_repeat(dst_buffer, chunkHeader.length);
+            break;
+        case CHUNK_ENCODING_ROTATE:
+            memcpy(dst_buffer, src_buffer, chunkHeader.length);
+            decode_chunk_rotate(dst_buffer, chunkHeader.length);
+            break;
+        }
+        return chunkHeader.length;
+    }
+
+    static size_t write_chunk_buffer(uint8 * dst_file, const uint8 * buffer, sawyercoding_chunk_header chunkHeader)
+    {
+        uint8 * encode_buffer;
+        uint8 * encode_buffer2;
+        switch (chunkHeader.encoding) {
+        case CHUNK_ENCODING_RLECOMPRESSED:
+            encode_buffer = (uint8 *)malloc(chunkHeader.length * 2);
+            encode_buffer2 = (uint8 *)malloc(0x600000);
+            chunkHeader.length = (uint32)encode_chunk_repeat(buffer, encode_buffer, chunkHeader.length);
+            chunkHeader.length = (uint32)encode_chunk_rle(encode_buffer, encode_buffer2, chunkHeader.length);
+            memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
+            memcpy(dst_file + sizeof(sawyercoding_chunk_header), encode_buffer2, chunkHeader.length);
+            free(encode_buffer2);
+            free(encode_buffer);
+            break;
+        case CHUNK_ENCODING_ROTATE:
+            encode_buffer = (uint8 *)malloc(chunkHeader.length);
+            memcpy(encode_buffer, buffer, chunkHeader.length);
+            encode_chunk_rotate(encode_buffer, chunkHeader.length);
+            memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
+            memcpy(dst_file + sizeof(sawyercoding_chunk_header), encode_buffer, chunkHeader.length);
+            free(encode_buffer);
+            break;
+        }
+        return chunkHeader.length + sizeof(sawyercoding_chunk_header);
+    }
+}
+
+class SawyerCodingEquivalence : public testing::Test
+{
+protected:
+    static constexpr size_t DATA_SIZE = 0x200000;
+
+    size_t _dataSize = DATA_SIZE;
+    size_t _bufferSize = 0;
+    std::vector<uint8> _data;
+    std::unique_ptr<uint8[]> _referenceBuffer;
+    std::unique_ptr<uint8[]> _buffer;
+
+    void SetUp() override
+    {
+        // Mimic a park: runs of empty space, records that repeat with small differences and noise
+        std::mt19937 rng(1234);
+        _data.reserve(_dataSize);
+        uint8 record[16] = { 0 };
+        while (_data.size() < _dataSize)
+        {
+            switch (rng() % 3) {
+            case 0:
+                _data.insert(_data.end(), rng() % 512, 0);
+                break;
+            case 1:
+                for (sint32 i = rng() % 64; i > 0; i--)
+                {
+                    record[rng() % sizeof(record)] = (uint8)rng();
+                    _data.insert(_data.end(), record, record + sizeof(record));
+                }
+                break;
+            case 2:
+                for (sint32 i = rng() % 256; i > 0; i--)
+                {
+                    _data.push_back((uint8)rng());
+                }
+                break;
+            }
+        }
+        _data.resize(_dataSize);
+
+        // Room for the encoded chunk, which is larger than the data when nothing compresses
+        _bufferSize = _dataSize * 3;
+        _referenceBuffer = std::make_unique<uint8[]>(_bufferSize);
+        _buffer = std::make_unique<uint8[]>(_bufferSize);
+    }
+
+    void CompareEncoding(uint8 encoding)
+    {
+        sawyercoding_chunk_header header;
+        header.encoding = encoding;
+        header.length = (uint32)_data.size();
+
+        size_t referenceEncodedSize = Reference::write_chunk_buffer(_referenceBuffer.get(), _data.data(), header);
+        size_t encodedSize = sawyercoding_write_chunk_buffer(_buffer.get(), _data.data(), header);
+        ASSERT_EQ(encodedSize, referenceEncodedSize);
+        ASSERT_EQ(memcmp(_buffer.get(), _referenceBuffer.get(), encodedSize), 0);
+
+        auto encoded = std::vector<uint8>(_buffer.get(), _buffer.get() + encodedSize);
+        const uint8 * encodedData = encoded.data() + sizeof(sawyercoding_chunk_header);
+        header.length = (uint32)(encodedSize - sizeof(sawyercoding_chunk_header));
+        size_t referenceDecodedSize = Reference::read_chunk_buffer(_referenceBuffer.get(), encodedData, header);
+        size_t decodedSize = sawyercoding_read_chunk_buffer(_buffer.get(), encodedData, header, _bufferSize);
+        ASSERT_EQ(decodedSize, _data.size());
+        ASSERT_EQ(referenceDecodedSize, _data.size());
+        ASSERT_EQ(memcmp(_buffer.get(), _data.data(), _data.size()), 0);
+        ASSERT_EQ(memcmp(_referenceBuffer.get(), _data.data(), _data.size()), 0);
+
+        // Decoding into a smaller destination keeps the start of the chunk
+        size_t truncatedLength = _data.size() / 3;
+        decodedSize = sawyercoding_read_chunk_buffer(_buffer.get(), encodedData, header, truncatedLength);
+        ASSERT_EQ(decodedSize, truncatedLength);
+        ASSERT_EQ(memcmp(_buffer.get(), _data.data(), truncatedLength), 0);
+    }
+};
+
+TEST_F(SawyerCodingEquivalence, rle_compressed)
+{
+    CompareEncoding(CHUNK_ENCODING_RLECOMPRESSED);
+}
+
+TEST_F(SawyerCodingEquivalence, rotate)
+{
+    CompareEncoding(CHUNK_ENCODING_ROTATE);
+}
+
+TEST_F(SawyerCodingEquivalence, checksum)
+{
+    uint32 referenceChecksum = Reference::calculate_checksum(_data.data(), _data.size());
+    uint32 checksum = sawyercoding_calculate_checksum(_data.data(), _data.size());
+    ASSERT_EQ(checksum, referenceChecksum);
+
+    // Unaligned lengths go through the byte at a time tail
+    for (size_t length = 0; length < 32; length++)
+    {
+        ASSERT_EQ(sawyercoding_calculate_checksum(_data.data() + 3, length),
+                  Reference::calculate_checksum(_data.data() + 3, length));
+    }
+}
+
+class SawyerCodingBenchmark : public SawyerCodingEquivalence
+{
+protected:
+    // About the size of the chunks in a large saved game
+    static constexpr size_t BENCHMARK_DATA_SIZE = 0x600000;
+    static constexpr sint32 ITERATIONS = 5;
+
+    SawyerCodingBenchmark()
+    {
+        _dataSize = BENCHMARK_DATA_SIZE;
+    }
+
+    static void Measure(const char * name, const std::function<void()> &fn)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (sint32 i = 0; i < ITERATIONS; i++)
+        {
+            fn();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count() / ITERATIONS;
+        std::printf("%-32s %10.3f ms\n", name, ms);
+    }
+
+    void MeasureEncoding(const char * name, uint8 encoding)
+    {
+        sawyercoding_chunk_header header;
+        header.encoding = encoding;
+        header.length = (uint32)_data.size();
+
+        size_t encodedSize = 0;
+        std::printf("%s, %u bytes\n", name, header.length);
+        Measure("  write (reference)", [&]() {
+            encodedSize = Reference::write_chunk_buffer(_referenceBuffer.get(), _data.data(), header);
+        });
+        Measure("  write", [&]() {
+            encodedSize = sawyercoding_write_chunk_buffer(_buffer.get(), _data.data(), header);
+        });
+
+        auto encoded = std::vector<uint8>(_buffer.get(), _buffer.get() + encodedSize);
+        const uint8 * encodedData = encoded.data() + sizeof(sawyercoding_chunk_header);
+        header.length = (uint32)(encodedSize - sizeof(sawyercoding_chunk_header));
+        Measure("  read (reference)", [&]() {
+            Reference::read_chunk_buffer(_referenceBuffer.get(), encodedData, header);
+        });
+        Measure("  read", [&]() {
+            sawyercoding_read_chunk_buffer(_buffer.get(), encodedData, header, _bufferSize);
+        });
+        ASSERT_EQ(memcmp(_buffer.get(), _data.data(), _data.size()), 0);
+    }
+};
+
+TEST_F(SawyerCodingBenchmark, DISABLED_encode_decode)
+{
+    MeasureEncoding("RLE compressed", CHUNK_ENCODING_RLECOMPRESSED);
+    MeasureEncoding("Rotate", CHUNK_ENCODING_ROTATE);
+
+    uint32 checksum = 0;
+    std::printf("Checksum, %u bytes\n", (uint32)_data.size());
+    Measure("  checksum (reference)", [&]() {
+        checksum += Reference::calculate_checksum(_data.data(), _data.size());
+    });
+    Measure("  checksum", [&]() {
+        checksum -= sawyercoding_calculate_checksum(_data.data(), _data.size());
+    });
+    ASSERT_EQ(checksum, 0u);
+}